@@ -0,0 +1,116 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The AutoTune function implements the auto-tune mode (AUTO_TUNE_FILE).
+   In this mode, the configuration of the search parameters is chosen
+   during the first part of the job's time budget (DEADLINE) from a list of
+   competing configurations. The rest of the budget is spent on solving the
+   problem with the chosen configuration.
+
+   The configurations are given in the format of the sweep file (see
+   Sweep). They are raced by successive halving. In each round, each
+   remaining configuration makes one short run with the same seed and the
+   same time limit. The configurations are ranked by the cost reached (the
+   gap), with ties broken by the time used, and the worse half is dropped.
+   The time limit of a run doubles from round to round, as the number of
+   configurations halves. The rounds together take AUTO_TUNE_FRACTION of
+   DEADLINE.
+
+   The preprocessing is done once, before the race (with the largest
+   MAX_CANDIDATES of all configurations; see Sweep). So the runs of the
+   race are not charged for it.
+
+   The chosen configuration is written to AUTO_TUNE_RESULT_FILE (if given)
+   as parameter settings, which may be copied into the parameter file of
+   later jobs.
+*/
+
+static double *Cost, *Time;     /* The result of the last run of each
+                                   configuration */
+
+static int CompareResults(const void *Ca, const void *Cb);
+
+void AutoTune()
+{
+    char **Configurations, *Label, *Field, *Rest;
+    long Count, Survivors, Rounds, Round, *Alive, i, n;
+    double Total, Slot, StartTime = GetWallTime(), LastTime;
+    FILE *File;
+
+    ResetParameters();
+    if (Deadline <= 0)
+        eprintf("AUTO_TUNE_FILE: DEADLINE expected");
+    Total = Deadline;
+    ReadProblemData();
+    Configurations = ReadConfigurations(AutoTuneFileName, &Count);
+    for (i = 0; i < Count; i++) {
+        ApplyConfiguration(Configurations[i]);
+        if (MaxCandidates > SweepCandidates)
+            SweepCandidates = MaxCandidates;
+    }
+    assert(Alive = (long *) malloc(Count * sizeof(long)));
+    assert(Cost = (double *) malloc(Count * sizeof(double)));
+    assert(Time = (double *) malloc(Count * sizeof(double)));
+    for (i = 0; i < Count; i++)
+        Alive[i] = i;
+    for (Rounds = 0, n = Count; n > 1; n = (n + 1) / 2)
+        Rounds++;
+    if (Count > 1) {
+        /* Preprocess (RUNS = 0) */
+        ApplyConfiguration(Configurations[0]);
+        Runs = 0;
+        Solve(0, 0);
+    }
+    for (Survivors = Count, Round = 1; Survivors > 1; Round++) {
+        Slot = AutoTuneFraction * Total / Rounds / Survivors;
+        for (i = 0; i < Survivors; i++) {
+            Label = ApplyConfiguration(Configurations[Alive[i]]);
+            Runs = 1;
+            Deadline = Slot;
+            LastTime = GetWallTime();
+            Solve(0, 0);
+            Cost[Alive[i]] = BestCost;
+            Time[Alive[i]] = GetWallTime() - LastTime;
+            printf("AUTO_TUNE round %ld: %s, Cost = %0.0f, "
+                   "Gap = %0.3f%%, Time = %0.3f sec.\n", Round, Label,
+                   BestCost, (BestCost - Optimum) / Optimum * 100.0,
+                   Time[Alive[i]]);
+            fflush(stdout);
+        }
+        qsort(Alive, Survivors, sizeof(long), CompareResults);
+        Survivors = (Survivors + 1) / 2;
+    }
+
+    /* Solve the problem with the chosen configuration */
+    Label = ApplyConfiguration(Configurations[Alive[0]]);
+    printf("AUTO_TUNE: %s chosen\n\n", Label);
+    fflush(stdout);
+    if (AutoTuneResultFileName) {
+        if (!(File = fopen(AutoTuneResultFileName, "w")))
+            eprintf("Cannot open AUTO_TUNE_RESULT_FILE: %s",
+                    AutoTuneResultFileName);
+        fprintf(File, "COMMENT : AUTO_TUNE result for %s\n",
+                ProblemFileName);
+        for (Field = Configurations[Alive[0]]; Field; Field = Rest) {
+            Rest = strchr(Field, ';');
+            fprintf(File, "%.*s\n", Rest ? (int) (Rest++ - Field) :
+                    (int) strlen(Field), Field);
+        }
+        fclose(File);
+    }
+    Deadline = Total - (GetWallTime() - StartTime);
+    if (Deadline <= 0)
+        Deadline = DBL_MIN;
+    Solve(0, 0);
+    free(Alive);
+    free(Cost);
+    free(Time);
+}
+
+static int CompareResults(const void *Ca, const void *Cb)
+{
+    long a = *(long *) Ca, b = *(long *) Cb;
+
+    return Cost[a] < Cost[b] ? -1 : Cost[a] > Cost[b] ? 1 :
+        Time[a] < Time[b] ? -1 : Time[a] > Time[b] ? 1 : 0;
+}
@@ -0,0 +1,285 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file implement backbone fixing (BACKBONE_FIX).
+
+   The CollectBackbone function is called by Solve after each run. During
+   the first BACKBONE_RUNS runs, it records the tour of the run (given by
+   the BestSuc fields). After the last of these runs, the edges that belong
+   to at least the fraction BACKBONE_FIX of the recorded tours (the
+   backbone) are fixed for the remaining runs.
+
+   The edges are fixed greedily, the most frequent (and then the shortest)
+   first. An edge is skipped if one of its end nodes already has two fixed
+   edges, or if it would close a cycle of fixed edges. The fixed edges are
+   added to the candidate sets, so that their costs are known (see C.c).
+
+   The fixed edges form paths. The inner nodes of the paths (the nodes
+   with two fixed edges) can never become an end node of an edge that is
+   added by a move, since both their tour edges are fixed. These nodes are
+   therefore removed from all candidate sets, and their own candidate sets
+   are reduced to their fixed edges. Each path is thus in effect collapsed
+   to an edge between its two end nodes, and the search works on a problem
+   with fewer nodes (the effective dimension). The end nodes get new
+   candidate sets among the end nodes near them (see CollapsePaths).
+
+   The remaining runs may still start from tours of the initial tour pool,
+   which need not contain the fixed edges. ChooseInitialTour splices the
+   fixed edges into such a tour, so that the inner nodes are never left
+   in places that the search could not repair.
+*/
+
+static long **Tours = 0;        /* The successor arrays of the tours */
+static int TourCount = 0, TourSpace = 0;
+static long LastRun = 0;        /* The run of the last recorded tour */
+
+typedef struct Edge {
+    Node *From, *To;
+    long Count;                 /* The number of tours that contain it */
+    long Cost;
+} Edge;
+
+static void FixBackbone();
+static long AddNear(Node * N, Node * To, long *Mark, Edge * Near,
+                    long Count);
+static long Find(long *Parent, long i);
+static int CompareEdges(const void *Ea, const void *Eb);
+
+void CollectBackbone(long Run)
+{
+    Node *N;
+
+    if (BackboneFraction <= 0 || Run > BackboneRuns)
+        return;
+    if (Run != LastRun + 1)
+        TourCount = 0;          /* A new job (or a resumed one) */
+    LastRun = Run;
+    if (TourCount == TourSpace) {
+        assert(Tours = (long **)
+               realloc(Tours, (TourSpace = BackboneRuns) *
+                       sizeof(long *)));
+        memset(Tours + TourCount, 0,
+               (TourSpace - TourCount) * sizeof(long *));
+    }
+    assert(Tours[TourCount] = (long *)
+           realloc(Tours[TourCount], (Dimension + 1) * sizeof(long)));
+    N = FirstNode;
+    do
+        Tours[TourCount][N->Id] = N->BestSuc->Id;
+    while ((N = N->BestSuc) != FirstNode);
+    TourCount++;
+    if (Run == BackboneRuns && Run < Runs)
+        FixBackbone();
+}
+
+static void FixBackbone()
+{
+    Edge *Edges;
+    Node *N, *To;
+    long *Parent, EdgeCount = 0, FixedEdges = 0, Effective = 0, i, j, a, b;
+    int k;
+
+    assert(Edges = (Edge *)
+           malloc(TourCount * Dimension * sizeof(Edge)));
+    assert(Parent = (long *) malloc((Dimension + 1) * sizeof(long)));
+
+    /* Count the occurrences of the edges of the tours */
+    for (k = 0; k < TourCount; k++) {
+        for (a = 1; a <= Dimension; a++) {
+            b = Tours[k][a];
+            for (j = 0; j < k; j++)
+                if (Tours[j][a] == b || Tours[j][b] == a)
+                    break;
+            if (j < k)
+                continue;       /* Counted with tour j */
+            Edges[EdgeCount].From = &NodeSet[a];
+            Edges[EdgeCount].To = &NodeSet[b];
+            Edges[EdgeCount].Cost = C(&NodeSet[a], &NodeSet[b]);
+            Edges[EdgeCount].Count = 1;
+            for (j = k + 1; j < TourCount; j++)
+                if (Tours[j][a] == b || Tours[j][b] == a)
+                    Edges[EdgeCount].Count++;
+            EdgeCount++;
+        }
+    }
+    qsort(Edges, EdgeCount, sizeof(Edge), CompareEdges);
+
+    /* The fixed paths, as a union-find structure over the node numbers */
+    for (a = 1; a <= Dimension; a++)
+        Parent[a] = a;
+    N = FirstNode;
+    do {
+        if (N->FixedTo1)
+            Parent[Find(Parent, N->Id)] = Find(Parent, N->FixedTo1->Id);
+        if (N->FixedTo2)
+            Parent[Find(Parent, N->Id)] = Find(Parent, N->FixedTo2->Id);
+    } while ((N = N->Suc) != FirstNode);
+
+    /* Fix the backbone edges */
+    for (i = 0; i < EdgeCount &&
+         Edges[i].Count >= BackboneFraction * TourCount - 1e-9; i++) {
+        N = Edges[i].From;
+        To = Edges[i].To;
+        if (Fixed(N, To) || N->FixedTo2 || To->FixedTo2 ||
+            (a = Find(Parent, N->Id)) == (b = Find(Parent, To->Id)))
+            continue;
+        Parent[a] = b;
+        if (N->FixedTo1)
+            N->FixedTo2 = To;
+        else
+            N->FixedTo1 = To;
+        if (To->FixedTo1)
+            To->FixedTo2 = N;
+        else
+            To->FixedTo1 = N;
+        AddCandidate(N, To, Edges[i].Cost);
+        AddCandidate(To, N, Edges[i].Cost);
+        FixedEdges++;
+    }
+
+    Effective = CollapsePaths();
+    if (TraceLevel >= 1) {
+        printf("BACKBONE: Fixed = %ld, Effective dimension = %ld\n\n",
+               FixedEdges, Effective);
+        fflush(stdout);
+    }
+    free(Edges);
+    free(Parent);
+}
+
+/*
+   The CollapsePaths function removes the inner nodes of the paths of fixed
+   edges from the search. The candidate set of an inner node is reduced to
+   its fixed edges. The candidate set of any other node (an end node) is
+   replaced by its fixed edge (if any) and the MaxCandidates nearest end
+   nodes among those that can be reached from it by at most two candidate
+   edges. The function returns the number of end nodes. It is also used by
+   MultiLevel.
+*/
+
+long CollapsePaths()
+{
+    Candidate **NewSet, *NN, *MM;
+    Edge *Near;
+    Node *N, *M, *To;
+    long *Mark, Count, FixedCount, Space = 0, Effective = 0, i;
+
+    assert(NewSet = (Candidate **)
+           calloc(Dimension + 1, sizeof(Candidate *)));
+    assert(Mark = (long *) calloc(Dimension + 1, sizeof(long)));
+    /* The largest candidate set */
+    N = FirstNode;
+    do {
+        for (Count = 0, NN = N->CandidateSet; NN && NN->To; NN++)
+            Count++;
+        if (Count > Space)
+            Space = Count;
+    } while ((N = N->Suc) != FirstNode);
+    Space = Space * (Space + 1);
+    assert(Near = (Edge *) malloc((Space + 1) * sizeof(Edge)));
+    N = FirstNode;
+    do {
+        if (!N->CandidateSet)
+            continue;
+        /* The fixed edges */
+        Count = 0;
+        for (NN = N->CandidateSet; (To = NN->To); NN++) {
+            if (Fixed(N, To)) {
+                Near[Count].To = To;
+                Near[Count++].Cost = NN->Cost;
+            }
+        }
+        FixedCount = Count;
+        if (!N->FixedTo2) {
+            /* The nearest end nodes */
+            Effective++;
+            Mark[N->Id] = N->Id;
+            for (NN = N->CandidateSet; (M = NN->To); NN++) {
+                Count = AddNear(N, M, Mark, Near, Count);
+                for (MM = M->CandidateSet; MM && (To = MM->To); MM++)
+                    Count = AddNear(N, To, Mark, Near, Count);
+            }
+            qsort(Near + FixedCount, Count - FixedCount, sizeof(Edge),
+                  CompareEdges);
+            if (Count > FixedCount + MaxCandidates)
+                Count = FixedCount + MaxCandidates;
+        }
+        assert(NewSet[N->Id] = (Candidate *)
+               malloc((Count + 1) * sizeof(Candidate)));
+        for (i = 0; i < Count; i++) {
+            NewSet[N->Id][i].To = Near[i].To;
+            NewSet[N->Id][i].Cost = Near[i].Cost;
+            NewSet[N->Id][i].Alpha = 0;
+        }
+        NewSet[N->Id][Count].To = 0;
+    } while ((N = N->Suc) != FirstNode);
+    N = FirstNode;
+    do {
+        if (!NewSet[N->Id])
+            continue;
+        free(N->CandidateSet);
+        N->CandidateSet = NewSet[N->Id];
+    } while ((N = N->Suc) != FirstNode);
+    free(NewSet);
+    free(Mark);
+    free(Near);
+    return Effective;
+}
+
+/*
+   The AddNear function adds the edge (N,To) to the list Near of Count
+   edges, unless To is an inner node of a path, or To has already been
+   added (Mark[To->Id] == N->Id). It returns the new number of edges.
+*/
+
+static long AddNear(Node * N, Node * To, long *Mark, Edge * Near,
+                    long Count)
+{
+    if (To->FixedTo2 || Mark[To->Id] == N->Id || Fixed(N, To))
+        return Count;
+    Mark[To->Id] = N->Id;
+    Near[Count].To = To;
+    Near[Count].Cost = C(N, To);
+    Near[Count].Count = 0;
+    return Count + 1;
+}
+
+/*
+   The AddCandidate function adds the edge (From,To) with cost Cost to the
+   candidate set of From (with alpha-value 0), if it is not already there.
+   The cost must be computed before the edge is fixed, since D_FUNCTION
+   treats fixed edges as having length 0.
+*/
+
+void AddCandidate(Node * From, Node * To, long Cost)
+{
+    Candidate *NN;
+    long Count = 0;
+
+    if (From->CandidateSet)
+        for (NN = From->CandidateSet; NN->To; NN++, Count++)
+            if (NN->To == To)
+                return;
+    assert(From->CandidateSet = (Candidate *)
+           realloc(From->CandidateSet, (Count + 2) * sizeof(Candidate)));
+    NN = From->CandidateSet + Count;
+    NN->To = To;
+    NN->Cost = Cost;
+    NN->Alpha = 0;
+    (NN + 1)->To = 0;
+}
+
+static long Find(long *Parent, long i)
+{
+    while (Parent[i] != i)
+        i = Parent[i] = Parent[Parent[i]];
+    return i;
+}
+
+static int CompareEdges(const void *Ea, const void *Eb)
+{
+    const Edge *a = (const Edge *) Ea, *b = (const Edge *) Eb;
+
+    return a->Count > b->Count ? -1 : a->Count < b->Count ? 1 :
+        a->Cost < b->Cost ? -1 : a->Cost > b->Cost ? 1 : 0;
+}
@@ -30,7 +30,8 @@ Node *Best2OptMoveSW(Node *t1, Node *t2, long *G0, long *Gain) {
     Node *t3, *t4, *T3, *T4 = 0;
     Candidate *Nt2, *NNa;
     long G1, G2, BestG2 = LONG_MIN;
-    int randomIndex, reelRandomIndex, lambdaCandidates, feasibleCandidat;
+    int reelRandomIndex, lambdaCandidates, feasibleCandidat;
+    CandidateSampler Sampler;
     double* probArray;
 
     if (SUC(t1) != t2)
@@ -43,10 +44,7 @@ Node *Best2OptMoveSW(Node *t1, Node *t2, long *G0, long *Gain) {
         Count++;
     }
 
-    int PossibleIndexes[Count];
-    for (int i = 0; i < Count; i++) {
-        PossibleIndexes[i] = i;
-    }
+    StartSampler(&Sampler, Count);
     // test
     // if lambda is bigger than the number of reel candidates
     if (Count < Lambda)
@@ -55,16 +53,8 @@ Node *Best2OptMoveSW(Node *t1, Node *t2, long *G0, long *Gain) {
     int l = 0;
     while (l < lambdaCandidates) {
         // Sampling bias : Giving higher sampling probability to candidates order
-        if (SamplingBiasUsed == 2){
-            randomIndex = (int) trunc(-log(GenerateRandomNonZero())/ log(2));
-            randomIndex = randomIndex  < (Count - l)  ? randomIndex  : Count - l - 1;
-        }
-        else if(SamplingBiasUsed == 1)
-            randomIndex = (int) Random() % Count;
-        else
-            randomIndex = l;
-
-        reelRandomIndex = PossibleIndexes[randomIndex];
+        if ((reelRandomIndex = NextSample(&Sampler)) < 0)
+            break;
 
         /* Choose (t2,t3) as a candidate edge emanating from t2 */
         Nt2 = &(t2->CandidateSet[reelRandomIndex]);
@@ -73,8 +63,6 @@ Node *Best2OptMoveSW(Node *t1, Node *t2, long *G0, long *Gain) {
         // if the Candidat is not feasible
         if (t3 == t2->Pred || t3 == t2->Suc ||
             ((G1 = *G0 - Nt2->Cost) <= 0 && GainCriterionUsed && ProblemType != HCP && ProblemType != HPP)) {
-            if (SamplingBiasUsed != 0)
-                ShiftToEnd(PossibleIndexes, Count, randomIndex);
             l++;
             continue;
         } else {
@@ -88,8 +76,6 @@ Node *Best2OptMoveSW(Node *t1, Node *t2, long *G0, long *Gain) {
                 return t4;
             }
             if (GainCriterionUsed && G2 - Precision < t4->Cost) {
-                if (SamplingBiasUsed != 0)
-                    ShiftToEnd(PossibleIndexes, Count, randomIndex);
                 l++;
                 continue;
             } else if (G2 > BestG2 &&
@@ -99,8 +85,6 @@ Node *Best2OptMoveSW(Node *t1, Node *t2, long *G0, long *Gain) {
                 T4 = t4;
                 BestG2 = G2;
             }
-            if (SamplingBiasUsed != 0)
-                ShiftToEnd(PossibleIndexes, Count, randomIndex);
             l++;
         }
     }
@@ -22,7 +22,8 @@
    contains the gain achieved by making the move.
 	
    If the composite move results in a shorter tour, then the move is made, and the 
-   function returns the gain achieved.	
+   function returns the gain achieved. In a worker thread (see Gain23) the move is 
+   not made; only the gain is returned.	
 */
 
 long BridgeGain(Node * s1, Node * s2, Node * s3, Node * s4,
@@ -36,10 +37,11 @@ long BridgeGain(Node * s1, Node * s2, Node * s3, Node * s4,
 
     /* From the original tour select a segment (u2 --> u3) which contains as
        few nodes as possible. The number of nodes in a segment is computed from
-       the rank (V) of its end points */
+       the positions (POSITION) of its end points */
     switch (Case6) {
     case 3:
-        if ((i = !Reversed ? s4->V - s5->V : s5->V - s4->V) < 0)
+        if ((i = !Reversed ? POSITION(s4) - POSITION(s5) :
+             POSITION(s5) - POSITION(s4)) < 0)
             i += Dimension;
         if (2 * i <= Dimension) {
             u2 = s5;
@@ -50,7 +52,8 @@ long BridgeGain(Node * s1, Node * s2, Node * s3, Node * s4,
         }
         break;
     case 4:
-        if ((i = !Reversed ? s5->V - s2->V : s2->V - s5->V) < 0)
+        if ((i = !Reversed ? POSITION(s5) - POSITION(s2) :
+             POSITION(s2) - POSITION(s5)) < 0)
             i += Dimension;
         if (2 * i <= Dimension) {
             u2 = s2;
@@ -62,7 +65,8 @@ long BridgeGain(Node * s1, Node * s2, Node * s3, Node * s4,
         break;
     case 0:
     case 7:
-        if ((i = !Reversed ? s3->V - s2->V : s2->V - s3->V) < 0)
+        if ((i = !Reversed ? POSITION(s3) - POSITION(s2) :
+             POSITION(s2) - POSITION(s3)) < 0)
             i += Dimension;
         if (2 * i <= Dimension) {
             u2 = s2;
@@ -112,6 +116,8 @@ long BridgeGain(Node * s1, Node * s2, Node * s3, Node * s4,
                 if (!Forbidden(t4, t1) &&
                     (!c || G2 - c(t4, t1) > 0) &&
                     (Gain = G2 - C(t4, t1)) > 0) {
+                    if (WorkerThread)
+                        return Gain;
                     switch (Case6) {
                     case 0:
                         if (X4 == 1)
@@ -174,6 +180,8 @@ long BridgeGain(Node * s1, Node * s2, Node * s3, Node * s4,
                     if (!Forbidden(t6, t1) &&
                         (!c || G4 - c(t6, t1) > 0) &&
                         (Gain = G4 - C(t6, t1)) > 0) {
+                        if (WorkerThread)
+                            return Gain;
                         if (X4 == 1)
                             Swap4(s1, s2, s4, t3, t4, t1, s1, s3, s2, t5,
                                   t6, t1);
@@ -228,6 +236,8 @@ long BridgeGain(Node * s1, Node * s2, Node * s3, Node * s4,
                         /* Test if an improvement can be achieved  */
                         if ((!c || G6 - c(t8, t1) > 0) &&
                             (Gain = G6 - C(t8, t1)) > 0) {
+                            if (WorkerThread)
+                                return Gain;
                             if (X4 == 1)
                                 Swap4(s1, s2, s4, t3, t4, t1, s1, s3, s2,
                                       t5, t6, t1);
@@ -27,7 +27,8 @@ long C_EXPLICIT(Node * Na, Node * Nb)
        been stored. 
 	    
    (3) Otherwise the distance function is called and the distance computed
-       is stored in the hash table.
+       is stored in the hash table (except in worker threads, which leave 
+       the table unchanged).
 	    
    [ see Bentley (1990): K-d trees for semidynamic point sets. ] 
 	      
@@ -52,6 +53,8 @@ long C_FUNCTION(Node * Na, Node * Nb)
         i = j;
     if (CacheSig[Index] == i)
         return CacheVal[Index];
+    if (WorkerThread)
+        return D(Na, Nb);
     CacheSig[Index] = i;
     return (CacheVal[Index] = D(Na, Nb));
 }
@@ -0,0 +1,213 @@
+#include <time.h>
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file save and restore the state of a job between
+   runs, so that a job that is interrupted can be resumed (checkpointing).
+
+   The WriteCheckpoint function writes the state to the file specified by
+   CheckpointFileName. The state consists of the penalties (Pi), the
+   fixed edges, the candidate sets, the node list, BestTour and BetterTour, the statistics
+   of the completed runs, the number of the next run, and the seed of the
+   random number generator at the start of that run. The file is binary. It
+   is written to a temporary file, which is then renamed, so that an
+   interrupted write never destroys the previous checkpoint.
+
+   Nothing happens if CheckpointFileName is 0, or if less than
+   CheckpointInterval seconds (wall clock) have elapsed since the last
+   checkpoint (unless Force is nonzero).
+
+   The ReadCheckpoint function restores the state from the checkpoint file,
+   if it exists. It returns 1 if the state has been restored; otherwise 0.
+   In the former case, CreateCandidateSet should not be called, and the
+   search is resumed from run number *Run. The file must have been written
+   for the same problem.
+
+   The WriteState and ReadState functions write and read the state on an
+   open stream. ReadState replaces CreateCandidateSet. Source names the
+   stream in error messages. The functions are also used for keeping the
+   result of the preprocessing in memory (see SavePreprocessing).
+
+   The functions are called from LKmain.
+*/
+
+static const char Magic[8] = "LKHCKPT2";
+static time_t LastCheckpoint = 0;
+
+#define Write(Value, Count, File)\
+    assert(fwrite(Value, sizeof(*(Value)), Count, File) == (size_t) (Count))
+#define Read(Value, Count, File)\
+    (fread(Value, sizeof(*(Value)), Count, File) == (size_t) (Count))
+
+void WriteCheckpoint(long Run, long TrialSum, long MinTrial,
+                     long Successes, double CostSum, double TimeSum,
+                     double MinTime, int Force)
+{
+    char *TempFileName;
+    FILE *File;
+
+    if (CheckpointFileName == 0 ||
+        (!Force && difftime(time(0), LastCheckpoint) < CheckpointInterval))
+        return;
+    assert(TempFileName =
+           (char *) malloc(strlen(CheckpointFileName) + 5));
+    sprintf(TempFileName, "%s.tmp", CheckpointFileName);
+    if (!(File = fopen(TempFileName, "wb")))
+        eprintf("Cannot open %s", TempFileName);
+    WriteState(File, Run, TrialSum, MinTrial, Successes, CostSum, TimeSum,
+               MinTime);
+    if (fclose(File) || rename(TempFileName, CheckpointFileName))
+        eprintf("Cannot write %s", CheckpointFileName);
+    free(TempFileName);
+    LastCheckpoint = time(0);
+}
+
+int ReadCheckpoint(long *Run, long *TrialSum, long *MinTrial,
+                   long *Successes, double *CostSum, double *TimeSum,
+                   double *MinTime)
+{
+    FILE *File;
+
+    if (CheckpointFileName == 0 || !(File = fopen(CheckpointFileName, "rb")))
+        return 0;
+    ReadState(File, CheckpointFileName, Run, TrialSum, MinTrial, Successes,
+              CostSum, TimeSum, MinTime);
+    fclose(File);
+    LastCheckpoint = time(0);
+    return 1;
+}
+
+void WriteState(FILE *File, long Run, long TrialSum, long MinTrial,
+                long Successes, double CostSum, double TimeSum,
+                double MinTime)
+{
+    Node *N;
+    Candidate *NN;
+    long i, Count;
+    int Id;
+
+    Write(Magic, 8, File);
+    Write(&Dimension, 1, File);
+    Write(&Run, 1, File);
+    Write(&Seed, 1, File);
+    Write(&TrialSum, 1, File);
+    Write(&MinTrial, 1, File);
+    Write(&Successes, 1, File);
+    Write(&CostSum, 1, File);
+    Write(&TimeSum, 1, File);
+    Write(&MinTime, 1, File);
+    Write(&BestCost, 1, File);
+    Write(&WorstCost, 1, File);
+    Write(&Optimum, 1, File);
+    Write(&LowerBound, 1, File);
+    Write(&Norm, 1, File);
+    Write(BestTour + 1, Dimension, File);
+    Write(BetterTour + 1, Dimension, File);
+    /* The node list, starting at FirstNode */
+    N = FirstNode;
+    do {
+        Id = N->Id;
+        Write(&Id, 1, File);
+    } while ((N = N->Suc) != FirstNode);
+    for (i = 1; i <= Dimension; i++) {
+        N = &NodeSet[i];
+        Write(&N->Pi, 1, File);
+        Id = N->Dad ? N->Dad->Id : 0;
+        Write(&Id, 1, File);
+        Id = N->FixedTo1 ? N->FixedTo1->Id : 0;
+        Write(&Id, 1, File);
+        Id = N->FixedTo2 ? N->FixedTo2->Id : 0;
+        Write(&Id, 1, File);
+        Count = -1;
+        if (N->CandidateSet)
+            for (Count = 0, NN = N->CandidateSet; NN->To; NN++)
+                Count++;
+        Write(&Count, 1, File);
+        for (NN = N->CandidateSet; Count > 0; Count--, NN++) {
+            Id = NN->To->Id;
+            Write(&Id, 1, File);
+            Write(&NN->Cost, 1, File);
+            Write(&NN->Alpha, 1, File);
+        }
+    }
+}
+
+void ReadState(FILE *File, char *Source, long *Run, long *TrialSum,
+               long *MinTrial, long *Successes, double *CostSum,
+               double *TimeSum, double *MinTime)
+{
+    Node *Na, *Nb;
+    Candidate *NN;
+    char M[8];
+    long i, j, Count, Dim;
+    int Id;
+
+    if (!Read(M, 8, File) || memcmp(M, Magic, 8) ||
+        !Read(&Dim, 1, File) || Dim != Dimension)
+        eprintf("%s does not match the problem",
+                Source);
+    if (!Read(Run, 1, File) || !Read(&Seed, 1, File) ||
+        !Read(TrialSum, 1, File) || !Read(MinTrial, 1, File) ||
+        !Read(Successes, 1, File) || !Read(CostSum, 1, File) ||
+        !Read(TimeSum, 1, File) || !Read(MinTime, 1, File) ||
+        !Read(&BestCost, 1, File) || !Read(&WorstCost, 1, File) ||
+        !Read(&Optimum, 1, File) || !Read(&LowerBound, 1, File) ||
+        !Read(&Norm, 1, File) ||
+        !Read(BestTour + 1, Dimension, File) ||
+        !Read(BetterTour + 1, Dimension, File))
+        eprintf("%s is truncated", Source);
+    for (i = 1, Na = 0; i <= Dimension; i++, Na = Nb) {
+        if (!Read(&Id, 1, File) || Id < 1 || Id > Dimension)
+            eprintf("%s is corrupt", Source);
+        Nb = &NodeSet[Id];
+        if (Na)
+            Link(Na, Nb);
+        else
+            FirstNode = Nb;
+    }
+    Link(Na, FirstNode);
+    for (i = 1; i <= Dimension; i++) {
+        Na = &NodeSet[i];
+        if (!Read(&Na->Pi, 1, File) || !Read(&Id, 1, File))
+            eprintf("%s is truncated", Source);
+        Na->Dad = Id ? &NodeSet[Id] : 0;
+        if (!Read(&Id, 1, File))
+            eprintf("%s is truncated", Source);
+        Na->FixedTo1 = Id ? &NodeSet[Id] : 0;
+        if (!Read(&Id, 1, File) || !Read(&Count, 1, File))
+            eprintf("%s is truncated", Source);
+        Na->FixedTo2 = Id ? &NodeSet[Id] : 0;
+        free(Na->CandidateSet);
+        Na->CandidateSet = 0;
+        if (Count < 0)
+            continue;
+        assert(Na->CandidateSet =
+               (Candidate *) malloc((Count + 1) * sizeof(Candidate)));
+        for (j = 0, NN = Na->CandidateSet; j < Count; j++, NN++) {
+            if (!Read(&Id, 1, File) || !Read(&NN->Cost, 1, File) ||
+                !Read(&NN->Alpha, 1, File))
+                eprintf("%s is truncated",
+                        Source);
+            NN->To = &NodeSet[Id];
+        }
+        NN->To = 0;
+    }
+    /* Transform the distance matrix as done by CreateCandidateSet */
+    if (C == C_EXPLICIT && ProblemType != HPP) {
+        Na = FirstNode;
+        do {
+            for (i = 1; i < Na->Id; i++)
+                Na->C[i] *= Precision;
+        } while ((Na = Na->Suc) != FirstNode);
+        do {
+            Nb = Na;
+            while ((Nb = Nb->Suc) != FirstNode) {
+                if (Na->Id > Nb->Id)
+                    Na->C[Nb->Id] += Na->Pi + Nb->Pi;
+                else
+                    Nb->C[Na->Id] += Na->Pi + Nb->Pi;
+            }
+        } while ((Na = Na->Suc) != FirstNode);
+    }
+    SRandom(Seed);
+}
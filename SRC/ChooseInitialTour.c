@@ -23,6 +23,25 @@ csd
    among the alternatives (a one-way list of nodes). 
 
    The sequence of chosen nodes constitutes the initial tour.
+
+   A fixed edge (N,NextN) is always chosen first, if possible.
+
+   If an initial tour is given (INITIAL_TOUR_FILE, or the InitialSuc fields
+   set by another function), its successor is chosen as NextN in the first
+   trial, and in every trial if SAMPLING_BIAS is LKH. Without an initial
+   tour, NextN is always chosen as described above. The same holds if the
+   successor has already been chosen, or if it has two incident fixed
+   edges (it must then be reached through one of them). Thus, the fixed
+   edges are spliced into a given tour that does not contain them (for
+   example, a tour of the pool after BACKBONE_FIX).
+
+   If KICK_TYPE is SEGMENT_DOUBLE_BRIDGE, every trial except the first one 
+   instead starts from the currently best tour of the run (recorded in the 
+   BestSuc fields), which is perturbed by the SegmentDoubleBridgeKick 
+   function. The best tour is normally restored by undoing the 2-opt moves
+   made since it was recorded (see RestoreBestTour). Otherwise, the tour
+   is relinked, and the nodes that get new neighbors are marked for the
+   worker threads (see MarkChanged).
 */
 
 void ChooseInitialTour() {
@@ -30,8 +49,25 @@ void ChooseInitialTour() {
     Candidate *NN;
     long i;
 
+    if (KickType == SEGMENT_DOUBLE_BRIDGE && Trial > 1) {
+        if (!RestoreBestTour()) {
+            N = FirstNode;
+            do {
+                if (N->Suc != N->BestSuc) {
+                    MarkChanged(N);
+                    MarkChanged(N->BestSuc);
+                }
+                Link(N, N->BestSuc);
+            } while ((N = N->BestSuc) != FirstNode);
+            ClearTrialLog();
+        }
+        SegmentDoubleBridgeKick();
+        return;
+    }
+    InvalidateTrialLog();
+
     /* Choose a random node N = FirstFirstNode */
-    N = FirstNode = &NodeSet[1 + rand() % Dimension];
+    N = FirstNode = &NodeSet[1 + Random() % Dimension];
 
     /* Mark all nodes as "not chosen" by setting their V field to zero */
     do
@@ -55,82 +91,70 @@ void ChooseInitialTour() {
     /* Mark FirstNode as chosen */
     FirstNode->V = 1;
     N = FirstNode;
-    if (SamplingBiasUsed == 1 || SamplingBiasUsed == 2) {
-        /* Loop as long as not all nodes have been chosen */
-        while (N->Suc != FirstNode) {
-            if (N->InitialSuc && Trial == 1)
-                NextN = N->InitialSuc;
-            else {
-                for (NN = N->CandidateSet; NextN = NN->To; NN++)
-                    if (!NextN->V && Fixed(N, NextN))
-                        break;
-            }
-            if (NextN == 0) {
-                FirstAlternative = 0;
-                i = 0;
-                if (ProblemType != HCP && ProblemType != HPP) {
-                    /* Try case A0 */
-                    for (NN = N->CandidateSet; NextN = NN->To; NN++) {
-                        if (!NextN->V && !NextN->FixedTo2 &&
-                            Near(N, NextN) && IsCommonEdge(N, NextN)) {
-                            i++;
-                            NextN->Next = FirstAlternative;
-                            FirstAlternative = NextN;
-                        }
+    /* Loop as long as not all nodes have been chosen */
+    while (N->Suc != FirstNode) {
+        for (NN = N->CandidateSet; NextN = NN->To; NN++)
+            if (!NextN->V && Fixed(N, NextN))
+                break;
+        if (!NextN && N->InitialSuc &&
+            (Trial == 1 || SamplingBiasUsed == 0) &&
+            !N->InitialSuc->V && !N->InitialSuc->FixedTo2)
+            NextN = N->InitialSuc;
+        if (NextN == 0) {
+            FirstAlternative = 0;
+            i = 0;
+            if (ProblemType != HCP && ProblemType != HPP) {
+                /* Try case A0 */
+                for (NN = N->CandidateSet; NextN = NN->To; NN++) {
+                    if (!NextN->V && !NextN->FixedTo2 &&
+                        Near(N, NextN) && IsCommonEdge(N, NextN)) {
+                        i++;
+                        NextN->Next = FirstAlternative;
+                        FirstAlternative = NextN;
                     }
                 }
-                if (i == 0 && MaxCandidates > 0 &&
-                    ProblemType != HCP && ProblemType != HPP) {
-                    /* Try case A */
-                    for (NN = N->CandidateSet; NextN = NN->To; NN++) {
-                        if (!NextN->V && !NextN->FixedTo2 &&
-                            NN->Alpha == 0 && InBestTour(N, NextN)) {
-                            i++;
-                            NextN->Next = FirstAlternative;
-                            FirstAlternative = NextN;
-                        }
+            }
+            if (i == 0 && MaxCandidates > 0 &&
+                ProblemType != HCP && ProblemType != HPP) {
+                /* Try case A */
+                for (NN = N->CandidateSet; NextN = NN->To; NN++) {
+                    if (!NextN->V && !NextN->FixedTo2 &&
+                        NN->Alpha == 0 && InBestTour(N, NextN)) {
+                        i++;
+                        NextN->Next = FirstAlternative;
+                        FirstAlternative = NextN;
                     }
                 }
-                if (i == 0) {
-                    /* Try case B */
-                    for (NN = N->CandidateSet; NextN = NN->To; NN++) {
-                        if (!NextN->V && !NextN->FixedTo2) {
-                            i++;
-                            NextN->Next = FirstAlternative;
-                            FirstAlternative = NextN;
-                        }
+            }
+            if (i == 0) {
+                /* Try case B */
+                for (NN = N->CandidateSet; NextN = NN->To; NN++) {
+                    if (!NextN->V && !NextN->FixedTo2) {
+                        i++;
+                        NextN->Next = FirstAlternative;
+                        FirstAlternative = NextN;
                     }
                 }
-                if (i == 0) {
-                    /* Try case C (actually, not really a random choice) */
-                    NextN = N->Suc;
-                    while ((NextN->FixedTo2 || Forbidden(N, NextN))
-                           && NextN->Suc != FirstNode)
-                        NextN = NextN->Suc;
-                } else {
-                    NextN = FirstAlternative;
-                    if (i > 1) {
-                        /* Select NextN at random among the alternatives */
-                        i = rand() % i;
-                        while (i--)
-                            NextN = NextN->Next;
-                    }
+            }
+            if (i == 0) {
+                /* Try case C (actually, not really a random choice) */
+                NextN = N->Suc;
+                while ((NextN->FixedTo2 || Forbidden(N, NextN))
+                       && NextN->Suc != FirstNode)
+                    NextN = NextN->Suc;
+            } else {
+                NextN = FirstAlternative;
+                if (i > 1) {
+                    /* Select NextN at random among the alternatives */
+                    i = Random() % i;
+                    while (i--)
+                        NextN = NextN->Next;
                 }
             }
-            /* Include NextN as the successor of N */
-            Follow(NextN, N);
-            N = NextN;
-            N->V = 1;
-        }
-    } else {
-        while (N->Suc != FirstNode) {
-            if (N->InitialSuc)
-                NextN = N->InitialSuc;
-
-            /* Include NextN as the successor of N */
-            Follow(NextN, N);
-            N = NextN;
-            N->V = 1;
         }
+        /* Include NextN as the successor of N */
+        Follow(NextN, N);
+        N = NextN;
+        N->V = 1;
     }
 }
@@ -0,0 +1,168 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The CloneNodes function copies all nodes and their candidate sets into
+   private arrays, *Clone and *CandidateSet, for use by a worker thread.
+   References to nodes are redirected to the copies, so that the copies
+   make up a tour of their own, which the worker can change without
+   affecting the tour of the master thread.
+
+   The arrays are allocated at the first call (*Clone == 0). The candidate
+   array is enlarged, if needed, and *CandidateSpace gives its capacity.
+
+   The function is called by the worker threads of LinKernighanParallel and
+   SwNeighborhoodParallel. The workers keep their copies from trial to
+   trial. A copy is made anew only when it cannot be brought up to date by
+   UpdateClone (see below).
+
+   The copy is complete, so that a worker can run the serial move functions
+   unchanged on it (see LinKernighanParallel). Its size is about
+   (Dimension + 1) * (sizeof(Node) + (MaxCandidates + 1) * sizeof(Candidate))
+   bytes per worker.
+*/
+
+#define Copy(N) ((N) ? Clone + ((N) - NodeSet) : 0)
+
+static void CopyNode(Node * Clone, Node * N);
+
+void CloneNodes(Node ** Clone, Candidate ** CandidateSet,
+                long *CandidateSpace)
+{
+    Node *N, *M;
+    Candidate *NN, *MM;
+    long Count = 0, i;
+
+    for (i = 1; i <= Dimension; i++) {
+        if ((NN = NodeSet[i].CandidateSet))
+            for (; NN->To; NN++)
+                Count++;
+        Count++;
+    }
+    if (Count > *CandidateSpace) {
+        *CandidateSpace = Count;
+        free(*CandidateSet);
+        assert(*CandidateSet =
+               (Candidate *) malloc(Count * sizeof(Candidate)));
+    }
+    if (!*Clone)
+        assert(*Clone = (Node *) malloc((Dimension + 1) * sizeof(Node)));
+    MM = *CandidateSet;
+    for (i = 1; i <= Dimension; i++) {
+        N = &NodeSet[i];
+        M = &(*Clone)[i];
+        CopyNode(*Clone, N);
+        M->CandidateSet = 0;
+        if (!N->CandidateSet)
+            continue;
+        M->CandidateSet = MM;
+        for (NN = N->CandidateSet; NN->To; NN++, MM++) {
+            *MM = *NN;
+            MM->To = *Clone + (NN->To - NodeSet);
+        }
+        (MM++)->To = 0;
+    }
+}
+
+/*
+   Between two trials the master thread changes the tour by other means
+   than 2-opt moves (for example, by a kick), and InitializeTrial changes
+   the Rank, OldPred, OldSuc and Cost fields of some of the nodes. A worker
+   that has replayed all moves committed by the master therefore only needs
+   a fresh copy of these nodes. The master marks them by calling
+   MarkChanged, and UpdateClone copies the marked nodes into a clone.
+
+   When the changes are too many to be marked one by one (a new tour, new
+   candidate sets, or another problem), the master calls MarkAllChanged
+   instead. The clones must then be made anew by CloneNodes.
+
+   The marks are counted in epochs. When all clones of a group of workers
+   have been brought up to date, the master calls ClearChanged, which
+   removes the marks and returns the number of the new epoch. A clone that
+   was brought up to date in epoch E may later be updated by UpdateClone if
+   CloneIsCurrent(E) is true, that is, if no other group of workers has
+   consumed the marks, and MarkAllChanged has not been called, since then.
+*/
+
+static long *Changed = 0;       /* The Ids of the marked nodes */
+static char *IsChanged = 0;     /* IsChanged[i] == 1, if node i is marked */
+static long ChangedCount = 0;   /* The number of marked nodes */
+static long ChangedDimension = 0; /* The Dimension of Changed and IsChanged */
+static long Epoch = 1;
+
+static void UnmarkAll();
+
+void MarkChanged(Node * N)
+{
+    if (ChangedDimension != Dimension) {
+        free(Changed);
+        free(IsChanged);
+        assert(Changed = (long *) malloc(Dimension * sizeof(long)));
+        assert(IsChanged = (char *) calloc(Dimension + 1, sizeof(char)));
+        ChangedDimension = Dimension;
+        ChangedCount = 0;
+        Epoch++;
+    }
+    if (!IsChanged[N->Id]) {
+        IsChanged[N->Id] = 1;
+        Changed[ChangedCount++] = N->Id;
+    }
+}
+
+void MarkAllChanged()
+{
+    UnmarkAll();
+    Epoch++;
+}
+
+void UpdateClone(Node * Clone)
+{
+    long i;
+
+    for (i = 0; i < ChangedCount; i++)
+        CopyNode(Clone, &NodeSet[Changed[i]]);
+}
+
+long ClearChanged()
+{
+    UnmarkAll();
+    return ++Epoch;
+}
+
+int CloneIsCurrent(long CloneEpoch)
+{
+    return CloneEpoch == Epoch;
+}
+
+static void UnmarkAll()
+{
+    while (ChangedCount > 0)
+        IsChanged[Changed[--ChangedCount]] = 0;
+}
+
+/*
+   The CopyNode function copies node N into its clone in Clone. The clone
+   keeps its own candidate set.
+*/
+
+static void CopyNode(Node * Clone, Node * N)
+{
+    Node *M = Clone + (N - NodeSet);
+    Candidate *CandidateSet = M->CandidateSet;
+
+    *M = *N;
+    M->Pred = Copy(N->Pred);
+    M->Suc = Copy(N->Suc);
+    M->OldPred = Copy(N->OldPred);
+    M->OldSuc = Copy(N->OldSuc);
+    M->BestSuc = Copy(N->BestSuc);
+    M->NextBestSuc = Copy(N->NextBestSuc);
+    M->Dad = Copy(N->Dad);
+    M->FixedTo1 = Copy(N->FixedTo1);
+    M->FixedTo2 = Copy(N->FixedTo2);
+    M->OptimumSuc = Copy(N->OptimumSuc);
+    M->InitialSuc = Copy(N->InitialSuc);
+    M->MergeSuc[0] = Copy(N->MergeSuc[0]);
+    M->MergeSuc[1] = Copy(N->MergeSuc[1]);
+    M->CandidateSet = CandidateSet;
+    M->Next = M->NextTouched = 0;
+}
@@ -13,6 +13,19 @@
    are common to two currently best tours. The candidate set is extended with those
    tour edges that are not present in the current set. The original candidate set
    is re-established at exit from FindTour.  
+
+   No new trial is started after EndTime (see DEADLINE).
+
+   If TraceLevel >= 2, the cost of each trial is printed. A trial after the
+   first one that improves the best tour of the run is marked with a '*',
+   so the trace shows whether the kicks (see KICK_TYPE) lead the search
+   away from its first local optimum.
+
+   In portfolio mode, each better tour is offered to the other workers
+   (PublishIncumbent), and the run continues from the incumbent of the
+   portfolio if its own best tour is clearly worse (AdoptIncumbent). The
+   adopted tour is not reached by 2-opt moves, so the trial log is then
+   invalidated (see InvalidateTrialLog).
 */
 
 double FindTour()
@@ -29,12 +42,20 @@ double FindTour()
     BetterCost = DBL_MAX;
     for (Trial = 1; Trial <= MaxTrials; Trial++) {
         ChooseInitialTour();
-        Cost = SW == 0 ? LinKernighan() : LinKernighanSW();
+        Cost = SW ? LinKernighanSW() :
+            LKThreads > 1 ? LinKernighanParallel() : LinKernighan();
         /*printf("TRIAL %ld : Cost = %0.0f, Time = %0.3f sec.\n\n",
                Trial, Cost, GetTime() - LastTime);*/
         if (Cost < BetterCost) {
+            if (TraceLevel >= 2 && Trial > 1) {
+                printf("* %ld: Cost = %0.0f, Time = %0.0f sec.\n",
+                       Trial, Cost, GetTime() - LastTime);
+                fflush(stdout);
+            }
             BetterCost = Cost;
             RecordBetterTour();
+            MarkAllChanged();
+            PublishIncumbent(Cost);
             if (BetterCost <= Optimum)
                 break;
             AdjustCandidateSet();
@@ -45,6 +66,18 @@ double FindTour()
                    Trial, Cost, GetTime() - LastTime);
             fflush(stdout);
         }
+        if ((Cost = AdoptIncumbent(BetterCost)) < BetterCost) {
+            InvalidateTrialLog();
+            BetterCost = Cost;
+            RecordBetterTour();
+            MarkAllChanged();
+            if (BetterCost <= Optimum)
+                break;
+            AdjustCandidateSet();
+            HashInitialize(HTable);
+        }
+        if (EndTime > 0 && GetWallTime() >= EndTime)
+            break;
     }
     if (Trial > MaxTrials)
         Trial = MaxTrials;
@@ -14,12 +14,16 @@
    two segments, and then reconnecting the segments by suitable
    settings of Pred and Suc of t1, t2, t3 and t4. In addition,
    Rank is updated for nodes in the reversed segment (Rank gives the
-   ordinal number of a node in the tour).
+   ordinal number of a node in the tour, 1...Dimension).
 
    Any of two segments defined by the 2-opt move may be reversed. The
    segment with the fewest number of nodes is reversed in order to
    speed up computations. The number of nodes in a segment is found 
-   from the Rank-values. 
+   from the Rank-values. If the two segments have the same number of
+   nodes, the segment reversed is the one having the end node with the
+   smallest Id. Thus, the inverse move reverses the same segment, and
+   RestoreTour restores Pred, Suc and Rank exactly (the worker threads of
+   LinKernighanParallel and SwNeighborhoodParallel rely on this).
 
    The move is pushed onto a stack of 2-opt moves. The stack makes it
    possible to undo moves (by the RestoreTour function).
@@ -48,7 +52,10 @@ void Flip(Node * t1, Node * t2, Node * t3)
     /* Find the segment with the fewest nodes */
     if ((R = t2->Rank - t3->Rank) < 0)
         R += Dimension;
-    if (2 * R >= Dimension) {
+    if (2 * R > Dimension ||
+        (2 * R == Dimension &&
+         (t2->Id < t4->Id ? t2->Id : t4->Id) <
+         (t1->Id < t3->Id ? t1->Id : t3->Id))) {
         s1 = t3;
         t3 = t2;
         t2 = s1;
@@ -64,7 +71,9 @@ void Flip(Node * t1, Node * t2, Node * t3)
         s2 = s1->Suc;
         s1->Suc = s1->Pred;
         s1->Pred = s2;
-        s1->Rank = R--;
+        s1->Rank = R;
+        if (--R < 1)
+            R = Dimension;
     }
     t3->Suc = t2;
     t2->Pred = t3;
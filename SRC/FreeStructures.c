@@ -2,7 +2,10 @@
 #include "INCLUDE/Heap.h"
 
 /*      
-   The FreeStructures function frees all allocated structures.
+   The FreeStructures function frees all allocated structures of the current
+   problem. It is called by ReadProblem before a new problem is read.
+   Structures whose size does not depend on the problem (such as HTable and
+   the SW move tree) are kept for reuse.
 */
 
 void FreeStructures()
@@ -15,6 +18,7 @@ void FreeStructures()
         } while ((N = Next) != FirstNode);
         FirstNode = 0;
     }
+    FirstTouched = 0;
     if (FirstSegment) {
         Segment *S = FirstSegment, *SPrev;
         do {
@@ -34,8 +38,6 @@ void FreeStructures()
     BetterTour = 0;
     free(SwapStack);
     SwapStack = 0;
-    free(HTable);
-    HTable = 0;
     free(Rand);
     Rand = 0;
     free(CacheSig);
@@ -1,3 +1,5 @@
+#include <pthread.h>
+#include <unistd.h>
 #include "INCLUDE/Segment.h"
 #include "INCLUDE/LK.h"
 
@@ -23,232 +25,488 @@
 
    The first move must have a positive gain. The second move is determined by 
    the BridgeGain function.
-*/
 
-long Gain23()
-{
-    Candidate *Ns2, *Ns4, *Ns6;
-    Node *s1, *s2, *s3, *s4, *s5, *s6, *s7, *s8;
-    long G0, G1, G2, G3, G4, G5, G6, Gain, Gain6, i;
-    int X2, X4, X6, X8, Case6, Case8;
+   If GAIN23 = ACTIVE, only starting edges (s1,s2) that are incident to a 
+   node whose tour neighbors have changed since the last unsuccessful call 
+   of Gain23 are tried. These "touched" nodes are recorded by the Touch 
+   function.
 
-/*  
-   The algorithm splits the set of possible moves up into a number disjunct subsets
-   (called "cases"). When s1, s2, ..., s6 has been chosen, Case6 is used to 
-   discriminate between 7 cases. When s1, s2, ..., s8 has been chosen, Case8 is used 
-   to discriminate between 11 cases. 
+   The function uses POSITION (see Segment.h) to compare positions of nodes 
+   in the tour. With the linked list representation these are the Rank 
+   values, which are kept up to date by the Flip function, so no numbering 
+   of the tour is needed.
 
-   A detailed description of the different cases can be found after the code.
+   If GAIN23_THREADS > 1, the starting edges are scanned by several threads
+   (see ParallelGain below). The move made is the same as in a serial scan.
 */
 
+static long Nonfeasible2OptGain(Node * s1);
+static long Nonfeasible3OptGain(Node * s1);
+static long ParallelGain(long (*StartGain) (Node *));
+
+long Gain23()
+{
+    Node *s1, *t;
+    long (*StartGain) (Node *), Gain;
+    int Phase, X2;
+#ifdef SEGMENT_LIST
+    long i = 0;
+#endif
+
     Reversed = 0;
-    i = 0;
+#ifdef SEGMENT_LIST
     s1 = FirstNode;
     do
         s1->V = ++i;
     while ((s1 = SUC(s1)) != FirstNode);
+#endif
 
-    /* Try any nonfeasible 2-opt move folllowed by a 2-, 3- or 4-opt move */
-    for (X2 = 1; X2 <= 2; X2++) {
-        Reversed ^= 1;
-        do {
-            s2 = SUC(s1);
-            if (Fixed(s1, s2))
+    /* Phase 1: Try any nonfeasible 2-opt move folllowed by a 2-, 3- or 
+                4-opt move.
+       Phase 2: Try any nonfeasible 2-, 3- or 4-opt move folllowed by a 
+                2-opt move */
+    for (Phase = 1; Phase <= 2; Phase++) {
+        StartGain = Phase == 1 ? Nonfeasible2OptGain : Nonfeasible3OptGain;
+        for (X2 = 1; X2 <= 2; X2++) {
+            Reversed ^= 1;
+            if (Gain23Threads > 1) {
+                if ((Gain = ParallelGain(StartGain)) > 0)
+                    return Gain;
                 continue;
-            G0 = C(s1, s2);
-            /* Choose (s2,s3) as a candidate edge emanating from s2 */
-            for (Ns2 = s2->CandidateSet; s3 = Ns2->To; Ns2++) {
-                if (s3 == s1 || (s4 = SUC(s3)) == s1 || Fixed(s3, s4))
-                    continue;
-                if ((i = !Reversed ? s3->V - s2->V : s2->V - s3->V) <= 0)
-                    i += Dimension;
-                if (2 * i > Dimension)
-                    continue;
-                G1 = G0 - Ns2->Cost;
-                G2 = G1 + C(s3, s4);
-                if (!Forbidden(s4, s1) &&
-                    (!c || G2 - c(s4, s1) > 0) &&
-                    (G3 = G2 - C(s4, s1)) > 0 &&
-                    (Gain =
-                     BridgeGain(s1, s2, s3, s4, 0, 0, 0, 0, 0, G3)) > 0)
+            }
+            if (Gain23Used != 2) {
+                s1 = FirstNode;
+                do
+                    if ((Gain = StartGain(s1)) > 0)
+                        return Gain;
+                while ((s1 = SUC(s1)) != FirstNode);
+                continue;
+            }
+            /* Try (t,SUC(t)) and (PRED(t),t) for each touched node t */
+            for (t = FirstTouched; t;
+                 t = t->NextTouched != t ? t->NextTouched : 0) {
+                if ((Gain = StartGain(t)) > 0)
                     return Gain;
+                s1 = PRED(t);
+                if (!s1->NextTouched && (Gain = StartGain(s1)) > 0)
+                    return Gain;
+            }
+        }
+    }
+    /* No improvement found. Forget the touched nodes */
+    while ((t = FirstTouched)) {
+        FirstTouched = t->NextTouched != t ? t->NextTouched : 0;
+        t->NextTouched = 0;
+    }
+    return 0;
+}
+
+/*
+   The ParallelGain function scans the starting nodes s1 of one phase and 
+   orientation using Gain23Threads threads. 
+
+   The starting nodes are placed in an array, Start, in the order in which 
+   the serial scan visits them. The array is processed in chunks of 
+   ChunkSize nodes, which the threads take in increasing order. The threads 
+   only read the tour (WorkerThread is set, so BridgeGain, Make3OptMove and 
+   Make4OptMove are not called to make a move, and the distance cache is not 
+   updated). Each improving s1 found lowers First, the smallest index of an 
+   improving s1, and no thread evaluates nodes beyond First. 
+
+   When all threads have finished, every s1 before First is known to give 
+   no improvement. The move starting at Start[First] is then made by the 
+   calling thread. Thus, the move made is the same as the one made by the 
+   serial scan.
+
+   The calling thread is helped by a pool of Gain23Threads - 1 threads. The
+   pool is created at the first call and kept for later calls; its threads
+   wait at a barrier between scans. The pool is created anew if
+   Gain23Threads changes, and in a child process created by fork (which
+   has no copies of the threads).
+*/
+
+#define ChunkSize 64
+
+typedef struct ScanJob {
+    Node **Start;                 /* The starting nodes in scan order */
+    long Count;                   /* The number of starting nodes */
+    long NextChunk;               /* The index of the next chunk to scan */
+    long First;                   /* The index of the first improving s1 */
+    long (*StartGain) (Node *);   /* The function to call for each s1 */
+    int Reversed;                 /* The orientation of the scan */
+    pthread_mutex_t Mutex;
+} ScanJob;
+
+static pthread_t *Pool = 0;      /* The threads of the pool */
+static int PoolSize;            /* The number of threads in Pool */
+static pid_t PoolPid;           /* The process that created the pool */
+static pthread_barrier_t PoolBarrier;
+static ScanJob *CurrentJob;     /* The scan to be made (0 terminates the pool) */
+
+static void StartPool();
+static void StopPool();
+
+static void *ScanChunks(void *Arg)
+{
+    ScanJob *Job = (ScanJob *) Arg;
+    long Lo, Hi, i;
+
+    WorkerThread = 1;
+    Reversed = Job->Reversed;
+    for (;;) {
+        pthread_mutex_lock(&Job->Mutex);
+        Lo = Job->NextChunk;
+        Job->NextChunk += ChunkSize;
+        Hi = Lo + ChunkSize < Job->First ? Lo + ChunkSize : Job->First;
+        pthread_mutex_unlock(&Job->Mutex);
+        if (Lo >= Hi)
+            break;
+        for (i = Lo; i < Hi; i++) {
+            if (i >= __atomic_load_n(&Job->First, __ATOMIC_RELAXED))
+                break;
+            if (Job->StartGain(Job->Start[i]) > 0) {
+                pthread_mutex_lock(&Job->Mutex);
+                if (i < Job->First)
+                    __atomic_store_n(&Job->First, i, __ATOMIC_RELAXED);
+                pthread_mutex_unlock(&Job->Mutex);
+                break;
             }
         }
-        while ((s1 = s2) != FirstNode);
     }
-    /* Try any nonfeasible 2-, 3- or 4-opt move folllowed by a 2-opt move */
-    for (X2 = 1; X2 <= 2; X2++) {
-        Reversed ^= 1;
-        do {
-            s2 = SUC(s1);
-            if (Fixed(s1, s2))
+    return 0;
+}
+
+/*
+   The RunPool function is executed by each thread of the pool.
+*/
+
+static void *RunPool(void *Arg)
+{
+    for (;;) {
+        pthread_barrier_wait(&PoolBarrier);
+        if (!CurrentJob)
+            break;
+        ScanChunks(CurrentJob);
+        pthread_barrier_wait(&PoolBarrier);
+    }
+    return 0;
+}
+
+static long ParallelGain(long (*StartGain) (Node *))
+{
+    static Node **Start = 0;
+    static long StartSpace = 0;
+    ScanJob Job;
+    Node *s1, *t;
+    long Count = 0;
+
+    if (2 * Dimension > StartSpace) {
+        StartSpace = 2 * Dimension;
+        assert(Start =
+               (Node **) realloc(Start, StartSpace * sizeof(Node *)));
+    }
+    if (Gain23Used != 2) {
+        s1 = FirstNode;
+        do
+            Start[Count++] = s1;
+        while ((s1 = SUC(s1)) != FirstNode);
+    } else {
+        for (t = FirstTouched; t;
+             t = t->NextTouched != t ? t->NextTouched : 0) {
+            Start[Count++] = t;
+            if (!(s1 = PRED(t))->NextTouched)
+                Start[Count++] = s1;
+        }
+    }
+    if (Count == 0)
+        return 0;
+    Job.Start = Start;
+    Job.Count = Job.First = Count;
+    Job.NextChunk = 0;
+    Job.StartGain = StartGain;
+    Job.Reversed = Reversed;
+    pthread_mutex_init(&Job.Mutex, 0);
+    StartPool();
+    CurrentJob = &Job;
+    pthread_barrier_wait(&PoolBarrier);
+    ScanChunks(&Job);
+    WorkerThread = 0;
+    pthread_barrier_wait(&PoolBarrier);
+    pthread_mutex_destroy(&Job.Mutex);
+    return Job.First < Count ? StartGain(Start[Job.First]) : 0;
+}
+
+/*
+   The StartPool function creates the pool of threads, unless it exists
+   already with Gain23Threads - 1 threads.
+*/
+
+static void StartPool()
+{
+    int i;
+
+    if (Pool && PoolPid != getpid())
+        /* Inherited from the parent process; the threads do not exist */
+        Pool = 0;
+    if (Pool && PoolSize != Gain23Threads - 1)
+        StopPool();
+    if (Pool)
+        return;
+    PoolSize = Gain23Threads - 1;
+    PoolPid = getpid();
+    assert(Pool = (pthread_t *) malloc(PoolSize * sizeof(pthread_t)));
+    pthread_barrier_init(&PoolBarrier, 0, PoolSize + 1);
+    for (i = 0; i < PoolSize; i++)
+        if (pthread_create(&Pool[i], 0, RunPool, 0))
+            eprintf("Gain23: Cannot create thread");
+}
+
+/*
+   The StopPool function terminates the threads of the pool.
+*/
+
+static void StopPool()
+{
+    int i;
+
+    CurrentJob = 0;
+    pthread_barrier_wait(&PoolBarrier);
+    for (i = 0; i < PoolSize; i++)
+        pthread_join(Pool[i], 0);
+    pthread_barrier_destroy(&PoolBarrier);
+    free(Pool);
+    Pool = 0;
+}
+
+/*
+   The Nonfeasible2OptGain function tries a nonfeasible 2-opt move starting
+   with the edge (s1,SUC(s1)), followed by a 2-, 3- or 4-opt move that joins
+   the two cycles.
+*/
+
+static long Nonfeasible2OptGain(Node * s1)
+{
+    Candidate *Ns2;
+    Node *s2, *s3, *s4;
+    long G0, G1, G2, G3, Gain, i;
+
+    s2 = SUC(s1);
+    if (Fixed(s1, s2))
+        return 0;
+    G0 = C(s1, s2);
+    /* Choose (s2,s3) as a candidate edge emanating from s2 */
+    for (Ns2 = s2->CandidateSet; s3 = Ns2->To; Ns2++) {
+        if (s3 == s1 || (s4 = SUC(s3)) == s1 || Fixed(s3, s4))
+            continue;
+        if ((i = !Reversed ? POSITION(s3) - POSITION(s2) :
+             POSITION(s2) - POSITION(s3)) <= 0)
+            i += Dimension;
+        if (2 * i > Dimension)
+            continue;
+        G1 = G0 - Ns2->Cost;
+        G2 = G1 + C(s3, s4);
+        if (!Forbidden(s4, s1) &&
+            (!c || G2 - c(s4, s1) > 0) &&
+            (G3 = G2 - C(s4, s1)) > 0 &&
+            (Gain =
+             BridgeGain(s1, s2, s3, s4, 0, 0, 0, 0, 0, G3)) > 0)
+            return Gain;
+    }
+    return 0;
+}
+
+/*
+   The Nonfeasible3OptGain function tries a nonfeasible 2-, 3- or 4-opt 
+   move starting with the edge (s1,SUC(s1)), followed by a 2-opt move that
+   joins the two cycles. Feasible 2- and 3-opt moves found on the way are 
+   made at once.
+*/
+
+static long Nonfeasible3OptGain(Node * s1)
+{
+    Candidate *Ns2, *Ns4, *Ns6;
+    Node *s2, *s3, *s4, *s5, *s6, *s7, *s8;
+    long G0, G1, G2, G3, G4, G5, G6, Gain, Gain6;
+    int X4, X6, X8, Case6, Case8;
+
+/*  
+   The algorithm splits the set of possible moves up into a number disjunct subsets
+   (called "cases"). When s1, s2, ..., s6 has been chosen, Case6 is used to 
+   discriminate between 7 cases. When s1, s2, ..., s8 has been chosen, Case8 is used 
+   to discriminate between 11 cases. 
+
+   A detailed description of the different cases can be found after the code.
+*/
+
+    s2 = SUC(s1);
+    if (Fixed(s1, s2))
+        return 0;
+    G0 = C(s1, s2);
+    /* Choose (s2,s3) as a candidate edge emanating from s2 */
+    for (Ns2 = s2->CandidateSet; s3 = Ns2->To; Ns2++) {
+        if (s3 == s2->Pred || s3 == s2->Suc ||
+            (G1 = G0 - Ns2->Cost) <= 0)
+            continue;
+        /* Choose s4 as one of s3's two neighbors on the tour */
+        for (X4 = 1; X4 <= 2; X4++) {
+            s4 = X4 == 1 ? PRED(s3) : SUC(s3);
+            if (Fixed(s3, s4))
                 continue;
-            G0 = C(s1, s2);
-            /* Choose (s2,s3) as a candidate edge emanating from s2 */
-            for (Ns2 = s2->CandidateSet; s3 = Ns2->To; Ns2++) {
-                if (s3 == s2->Pred || s3 == s2->Suc ||
-                    (G1 = G0 - Ns2->Cost) <= 0)
+            G2 = G1 + C(s3, s4);
+            if (X4 == 1 &&
+                !Forbidden(s4, s1) &&
+                (!c || G2 - c(s4, s1) > 0) &&
+                (Gain = G2 - C(s4, s1)) > 0) {
+                if (!WorkerThread)
+                    Swap1(s1, s2, s3);
+                return Gain;
+            }
+            /* Choose (s4,s5) as a candidate edge emanating from s4 */
+            for (Ns4 = s4->CandidateSet; s5 = Ns4->To; Ns4++) {
+                if (s5 == s4->Pred || s5 == s4->Suc ||
+                    (G3 = G2 - Ns4->Cost) <= 0)
                     continue;
-                /* Choose s4 as one of s3's two neighbors on the tour */
-                for (X4 = 1; X4 <= 2; X4++) {
-                    s4 = X4 == 1 ? PRED(s3) : SUC(s3);
-                    if (Fixed(s3, s4))
+                /* Choose s6 as one of s5's two neighbors on the tour */
+                for (X6 = 1; X6 <= 2; X6++) {
+                    if (X4 == 1) {
+                        if (X6 == 1) {
+                            Case6 = 1 + !BETWEEN(s2, s5, s4);
+                            s6 = Case6 == 1 ? SUC(s5) : PRED(s5);
+                        } else {
+                            s6 = s6 ==
+                                s5->Pred ? s5->Suc : s5->Pred;
+                            if (s5 == s1 || s6 == s1)
+                                continue;
+                            Case6 += 2;
+                        }
+                    } else if (BETWEEN(s2, s5, s3)) {
+                        Case6 = 4 + X6;
+                        s6 = X6 == 1 ? SUC(s5) : PRED(s5);
+                        if (s6 == s1)
+                            continue;
+                    } else {
+                        if (X6 == 2)
+                            break;
+                        Case6 = 7;
+                        s6 = PRED(s5);
+                    }
+                    if (Fixed(s5, s6))
                         continue;
-                    G2 = G1 + C(s3, s4);
-                    if (X4 == 1 &&
-                        !Forbidden(s4, s1) &&
-                        (!c || G2 - c(s4, s1) > 0) &&
-                        (Gain = G2 - C(s4, s1)) > 0) {
-                        Swap1(s1, s2, s3);
-                        return Gain;
+                    G4 = G3 + C(s5, s6);
+                    Gain6 = 0;
+                    if (!Forbidden(s6, s1) &&
+                        (!c || G4 - c(s6, s1) > 0) &&
+                        (Gain6 = G4 - C(s6, s1)) > 0) {
+                        if (Case6 <= 2 || Case6 == 5 || Case6 == 6) {
+                            if (!WorkerThread)
+                                Make3OptMove(s1, s2, s3, s4, s5, s6,
+                                             Case6);
+                            return Gain6;
+                        }
+                        if ((Gain =
+                             BridgeGain(s1, s2, s3, s4, s5, s6, 0,
+                                        0, Case6, Gain6)) > 0)
+                            return Gain;
                     }
-                    /* Choose (s4,s5) as a candidate edge emanating from s4 */
-                    for (Ns4 = s4->CandidateSet; s5 = Ns4->To; Ns4++) {
-                        if (s5 == s4->Pred || s5 == s4->Suc ||
-                            (G3 = G2 - Ns4->Cost) <= 0)
+                    /* Choose (s6,s7) as a candidate edge emanating from s6 */
+                    for (Ns6 = s6->CandidateSet; s7 = Ns6->To;
+                         Ns6++) {
+                        if (s7 == s6->Pred || s7 == s6->Suc
+                            || (s6 == s2 && s7 == s3) || (s6 == s3
+                                                          && s7 ==
+                                                          s2)
+                            || (G5 = G4 - Ns6->Cost) <= 0)
                             continue;
                         /* Choose s6 as one of s5's two neighbors on the tour */
-                        for (X6 = 1; X6 <= 2; X6++) {
-                            if (X4 == 1) {
-                                if (X6 == 1) {
-                                    Case6 = 1 + !BETWEEN(s2, s5, s4);
-                                    s6 = Case6 == 1 ? SUC(s5) : PRED(s5);
-                                } else {
-                                    s6 = s6 ==
-                                        s5->Pred ? s5->Suc : s5->Pred;
-                                    if (s5 == s1 || s6 == s1)
-                                        continue;
-                                    Case6 += 2;
+                        for (X8 = 1; X8 <= 2; X8++) {
+                            if (X8 == 1) {
+                                Case8 = Case6;
+                                switch (Case6) {
+                                case 1:
+                                    s8 = BETWEEN(s2, s7,
+                                                 s5) ? SUC(s7) :
+                                        PRED(s7);
+                                    break;
+                                case 2:
+                                    s8 = BETWEEN(s3, s7,
+                                                 s6) ? SUC(s7) :
+                                        PRED(s7);
+                                    break;
+                                case 3:
+                                    if (BETWEEN(s5, s7, s4))
+                                        s8 = SUC(s7);
+                                    else {
+                                        s8 = BETWEEN(s3, s7,
+                                                     s1) ? PRED(s7)
+                                            : SUC(s7);
+                                        Case8 = 17;
+                                    }
+                                    break;
+                                case 4:
+                                    if (BETWEEN(s2, s7, s5))
+                                        s8 = BETWEEN(s2, s7,
+                                                     s4) ? SUC(s7)
+                                            : PRED(s7);
+                                    else {
+                                        s8 = PRED(s7);
+                                        Case8 = 18;
+                                    }
+                                    break;
+                                case 5:
+                                    s8 = PRED(s7);
+                                    break;
+                                case 6:
+                                    s8 = BETWEEN(s2, s7,
+                                                 s3) ? SUC(s7) :
+                                        PRED(s7);
+                                    break;
+                                case 7:
+                                    if (BETWEEN(s2, s7, s3))
+                                        s8 = SUC(s7);
+                                    else {
+                                        s8 = BETWEEN(s5, s7,
+                                                     s1) ? PRED(s7)
+                                            : SUC(s7);
+                                        Case8 = 19;
+                                    }
                                 }
-                            } else if (BETWEEN(s2, s5, s3)) {
-                                Case6 = 4 + X6;
-                                s6 = X6 == 1 ? SUC(s5) : PRED(s5);
-                                if (s6 == s1)
-                                    continue;
                             } else {
-                                if (X6 == 2)
+                                if (Case8 >= 17 ||
+                                    (Case6 != 3 && Case6 != 4
+                                     && Case6 != 7))
                                     break;
-                                Case6 = 7;
-                                s6 = PRED(s5);
+                                s8 = s7->Pred ? s7->Suc : s7->Pred;
+                                Case8 += 8;
                             }
-                            if (Fixed(s5, s6))
+                            if (s8 == s1 ||
+                                (s7 == s1 && s8 == s2) ||
+                                (s7 == s3 && s8 == s4) ||
+                                (s7 == s4 && s8 == s3))
                                 continue;
-                            G4 = G3 + C(s5, s6);
-                            Gain6 = 0;
-                            if (!Forbidden(s6, s1) &&
-                                (!c || G4 - c(s6, s1) > 0) &&
-                                (Gain6 = G4 - C(s6, s1)) > 0) {
-                                if (Case6 <= 2 || Case6 == 5 || Case6 == 6) {
-                                    Make3OptMove(s1, s2, s3, s4, s5, s6,
-                                                 Case6);
-                                    return Gain6;
-                                }
-                                if ((Gain =
-                                     BridgeGain(s1, s2, s3, s4, s5, s6, 0,
-                                                0, Case6, Gain6)) > 0)
+                            if (Fixed(s7, s8) || Forbidden(s8, s1))
+                                continue;
+                            G6 = G5 + C(s7, s8);
+                            if ((!c || G6 - c(s8, s1) > 0) &&
+                                (Gain = G6 - C(s8, s1)) > 0) {
+                                if (Case8 <= 15) {
+                                    if (!WorkerThread)
+                                        Make4OptMove(s1, s2, s3, s4,
+                                                     s5, s6, s7, s8,
+                                                     Case8);
                                     return Gain;
-                            }
-                            /* Choose (s6,s7) as a candidate edge emanating from s6 */
-                            for (Ns6 = s6->CandidateSet; s7 = Ns6->To;
-                                 Ns6++) {
-                                if (s7 == s6->Pred || s7 == s6->Suc
-                                    || (s6 == s2 && s7 == s3) || (s6 == s3
-                                                                  && s7 ==
-                                                                  s2)
-                                    || (G5 = G4 - Ns6->Cost) <= 0)
-                                    continue;
-                                /* Choose s6 as one of s5's two neighbors on the tour */
-                                for (X8 = 1; X8 <= 2; X8++) {
-                                    if (X8 == 1) {
-                                        Case8 = Case6;
-                                        switch (Case6) {
-                                        case 1:
-                                            s8 = BETWEEN(s2, s7,
-                                                         s5) ? SUC(s7) :
-                                                PRED(s7);
-                                            break;
-                                        case 2:
-                                            s8 = BETWEEN(s3, s7,
-                                                         s6) ? SUC(s7) :
-                                                PRED(s7);
-                                            break;
-                                        case 3:
-                                            if (BETWEEN(s5, s7, s4))
-                                                s8 = SUC(s7);
-                                            else {
-                                                s8 = BETWEEN(s3, s7,
-                                                             s1) ? PRED(s7)
-                                                    : SUC(s7);
-                                                Case8 = 17;
-                                            }
-                                            break;
-                                        case 4:
-                                            if (BETWEEN(s2, s7, s5))
-                                                s8 = BETWEEN(s2, s7,
-                                                             s4) ? SUC(s7)
-                                                    : PRED(s7);
-                                            else {
-                                                s8 = PRED(s7);
-                                                Case8 = 18;
-                                            }
-                                            break;
-                                        case 5:
-                                            s8 = PRED(s7);
-                                            break;
-                                        case 6:
-                                            s8 = BETWEEN(s2, s7,
-                                                         s3) ? SUC(s7) :
-                                                PRED(s7);
-                                            break;
-                                        case 7:
-                                            if (BETWEEN(s2, s7, s3))
-                                                s8 = SUC(s7);
-                                            else {
-                                                s8 = BETWEEN(s5, s7,
-                                                             s1) ? PRED(s7)
-                                                    : SUC(s7);
-                                                Case8 = 19;
-                                            }
-                                        }
-                                    } else {
-                                        if (Case8 >= 17 ||
-                                            (Case6 != 3 && Case6 != 4
-                                             && Case6 != 7))
-                                            break;
-                                        s8 = s7->Pred ? s7->Suc : s7->Pred;
-                                        Case8 += 8;
-                                    }
-                                    if (s8 == s1 ||
-                                        (s7 == s1 && s8 == s2) ||
-                                        (s7 == s3 && s8 == s4) ||
-                                        (s7 == s4 && s8 == s3))
-                                        continue;
-                                    if (Fixed(s7, s8) || Forbidden(s8, s1))
-                                        continue;
-                                    G6 = G5 + C(s7, s8);
-                                    if ((!c || G6 - c(s8, s1) > 0) &&
-                                        (Gain = G6 - C(s8, s1)) > 0) {
-                                        if (Case8 <= 15) {
-                                            Make4OptMove(s1, s2, s3, s4,
-                                                         s5, s6, s7, s8,
-                                                         Case8);
-                                            return Gain;
-                                        }
-                                        if (Gain > Gain6 &&
-                                            (Gain =
-                                             BridgeGain(s1, s2, s3, s4, s5,
-                                                        s6, s7, s8, Case6,
-                                                        Gain)) > 0)
-                                            return Gain;
-                                    }
                                 }
+                                if (Gain > Gain6 &&
+                                    (Gain =
+                                     BridgeGain(s1, s2, s3, s4, s5,
+                                                s6, s7, s8, Case6,
+                                                Gain)) > 0)
+                                    return Gain;
                             }
                         }
                     }
                 }
             }
         }
-        while ((s1 = s2) != FirstNode);
     }
     return 0;
 }
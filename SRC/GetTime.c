@@ -1,4 +1,5 @@
 #include <time.h>
+#include <sys/time.h>
 
 /*
 * The GetTime function is used to measure execution time.
@@ -10,12 +11,15 @@
 *
 * If the system call getrusage() is supported, the difference 
 * gives the user time used; otherwise, the accounted real time.
+*
+* The GetWallTime function returns the real (wall clock) time in seconds.
 */
 
 /* Define if you have the getrusage function */
 #define HAVE_GETRUSAGE
 
 double GetTime();
+double GetWallTime();
 
 #ifdef HAVE_GETRUSAGE
 #include <sys/types.h>
@@ -41,3 +45,10 @@ double GetTime()
 }
 
 #endif
+
+double GetWallTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
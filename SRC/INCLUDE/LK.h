@@ -10,6 +10,7 @@
 #include <ctype.h>
 #include <limits.h>
 #include <math.h>
+#include <setjmp.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -40,6 +41,9 @@ enum EdgeWeightFormats {FUNCTION, FULL_MATRIX, UPPER_ROW, LOWER_ROW,
                         UPPER_DIAG_ROW, LOWER_DIAG_ROW, UPPER_COL, LOWER_COL, 			        
                         UPPER_DIAG_COL, LOWER_DIAG_COL};
 enum CoordTypes {TWOD_COORDS, THREED_COORDS, NO_COORDS};
+enum KickTypes {RANDOM_RESTART, SEGMENT_DOUBLE_BRIDGE};
+enum SwStrategies {BREADTH, BEAM};
+enum Partitionings {NO_PARTITIONING, KARP, KMEANS};
 
 struct Candidate;
 struct Segment;
@@ -72,6 +76,7 @@ typedef struct Node {
     struct Node *Dad;        /* The father of the node in the minimum 1-tree */
     struct Node *Next;       /* An auxiliary pointer, usually to the next node in
                                 a list of nodes (e.g., the list of "active" nodes) */
+    struct Node *NextTouched;/* The next node in the list of "touched" nodes */
     struct Node *FixedTo1,	
                 *FixedTo2;   /* Pointers to the opposite end nodes of fixed edges.
                                 A maximum of two fixed edges can be incident to a node */
@@ -113,6 +118,17 @@ typedef struct SwapRecord {
     Node *t1, *t2, *t3, *t4;    /* The 4 nodes involved in a 2-opt move */
 } SwapRecord;
 
+/* The CandidateSampler structure is used to sample candidate edges without
+   replacement (see Sampler.c) */
+
+#define SamplerWords 4
+
+typedef struct CandidateSampler {
+    unsigned long long Mask[SamplerWords]; /* The remaining indices */
+    int Count;                  /* The number of indices */
+    int Left;                   /* The number of remaining indices */
+} CandidateSampler;
+
 typedef struct ImprovingMove{
     Node *t1, *t2, *t3, *t4;    /* The 4 nodes involved in the move */
     long Gain;
@@ -151,17 +167,27 @@ typedef struct Neighborhood {
 /* Extern variables: */
 
 extern SwapMove *SwapTree;
-extern SwapMove *BestSwapTree;
+extern __thread SwapMove *BestSwapTree;
 extern SwapMove **NegativeSwapList;
-extern SwapMove **Queue;
+extern __thread SwapMove **Queue;
 
-extern int coNodes;
+extern __thread int coNodes;
 extern int maxCoNodes;
 
 extern Neighborhood *NegativeNeighbors;
 
 extern int GainCriterionUsed;  /* Specifies whether L&K's gain criterion is used */
-extern int Gain23Used; /* Specifies whether Gain23 is used */
+extern int Gain23Used; /* Specifies whether Gain23 is used (0 = no, 1 = yes, 
+                          2 = only from touched nodes) */
+extern int Gain23Threads;       /* The number of threads used by Gain23 */
+extern int LKThreads;           /* The number of worker threads used by 
+                                   LinKernighanParallel */
+extern int SwThreads;           /* The number of worker threads used by 
+                                   SwNeighborhoodParallel */
+extern int SwStrategy;          /* Specifies how the SW move tree is explored:
+                                   BREADTH or BEAM */
+extern int BeamWidth;           /* The number of moves kept per level when
+                                   SwStrategy is BEAM */
 
 extern int SW;                  /* If SW (Stochastic Walk) is used instead */
 extern int SamplingBiasUsed;    /* Sampling bias for candidates : Giving higher sampling probability to candidates order */
@@ -169,12 +195,50 @@ extern int Lambda;              /* The number of candidates selected for the SW
 extern int MaxDepth;            /* Maximum depth allowed in the SW local search */
 extern int TrialTimeBudget;          /* Time for SW iteration */
 extern double PrintGapTime;
+extern double TourFileInterval; /* The minimum time in seconds between two
+                                   writes of the tour file */
+extern double CheckpointInterval; /* The minimum time in seconds between two
+                                     checkpoints */
+extern double Deadline;         /* The maximum time in seconds (wall clock) for
+                                   solving a problem (0 = no limit) */
+extern double EndTime;          /* The wall clock time at which the search 
+                                   ends (0 = no limit) */
+extern double BackboneFraction; /* The fraction of the tours of the first runs
+                                   that an edge must belong to in order to 
+                                   be fixed */
+extern long BackboneRuns;       /* The number of these runs */
+extern int MergeTourCount;      /* The number of best tours of the runs that
+                                   are merged after the last run */
+extern int PartitionCrossoverUsed; /* Specifies whether the tours of the runs
+                                      are recombined by partition crossover */
+extern long SubproblemSize;     /* The number of nodes of a tour segment
+                                   subproblem (0 = no subproblems) */
+extern int Partitioning;        /* The partitioning of the problem into
+                                   cells: NO_PARTITIONING, KARP or KMEANS */
+extern long PartitionSize;      /* The maximum number of nodes of a cell */
+extern int MultiLevels;         /* The maximum number of levels of multi-level
+                                   refinement (0 = no refinement) */
+extern int ServerQueue;         /* The maximum number of waiting requests */
+extern int ServerWorkers;       /* The number of worker processes of the 
+                                   server */
+extern void (*TourCallback)(double Cost); /* If not 0, called with the cost
+                                   of each new best tour (in BestTour) */
+extern jmp_buf *ErrorReturn;    /* If not 0, eprintf returns here instead of
+                                   exiting */
+extern char ErrorMessage[256];  /* The message of the last error */
+extern double AutoTuneFraction; /* The fraction of the deadline spent on
+                                   choosing a configuration */
+extern double PortfolioMargin;  /* The fraction by which a worker's tour must
+                                   be worse than the incumbent before the 
+                                   worker continues from the incumbent */
+extern long SweepCandidates;    /* The number of candidates computed for
+                                   all configurations of a sweep */
 extern int IntensificationDiversificationBest;
 extern int IntensificationDiversificationAny;
 
 extern double SwNeighborhoodStartTime;
 extern double SwNeighborhoodLimitTimeExceed;
-extern int ExitSwNeighborhood;
+extern volatile int ExitSwNeighborhood;
 
 extern int idMove;
 extern ImprovingMove *BestImprovingMoves;
@@ -195,6 +259,7 @@ extern long MaxTrials;          /* The maximum number of trials in each run */
 extern long MaxSwaps;           /* The maximum number of swaps made during the search 
                                    for a move */
 extern double BestCost;         /* The cost of the tour in BestTour */
+extern double WorstCost;        /* The cost of the worst tour found in a run */
 extern double Excess;           /* The maximum alpha-value allowed for any candidate 
                                    edge is set to Excess times the absolute value of 
                                    the lower bound of a solution tour */
@@ -204,6 +269,8 @@ extern double Optimum;          /* Known optimal tour length. A run will be term
 extern unsigned int Seed;       /* The initial seed for random number generation */
 extern int Subgradient;         /* Specifies whether the pi-values should be determined 
                                    by subgradient optimization */
+extern int KickType;            /* Specifies how a trial chooses its initial tour: 
+                                   RANDOM_RESTART or SEGMENT_DOUBLE_BRIDGE */
 extern int MoveType;            /* Specifies the move type to be used in the local search.  
                                    The value r (= 2, 3, 4 or 5) signifies that a r-opt 
                                    move is to be used. */                                    
@@ -221,9 +288,11 @@ extern Node *NodeSet;           /* Array of all nodes */
 extern Node *FirstNode;         /* The first node in the list of nodes */			
 extern Node *FirstActive, 
             *LastActive;        /* The first and last node in the list of "active" nodes */
+extern Node *FirstTouched;      /* The first node in the list of "touched" nodes */
 extern Node **Heap;             /* The heap used for computing minimum spanning trees */
-extern SwapRecord *SwapStack;   /* The stack of SwapRecords */
-extern long Swaps;              /* The number of swaps made during a tentative move */
+extern __thread SwapRecord *SwapStack;
+                                /* The stack of SwapRecords (one for each thread) */
+extern __thread long Swaps;     /* The number of swaps made during a tentative move */
 extern long Norm;               /* A measure of a 1-tree's discrepancy from a tour */
 extern long M;                  /* The M-value used when solving an ATSP-problem by
                                    transforming it to a TSP-problem */
@@ -236,10 +305,17 @@ extern long *CacheSig;          /* A table of the signatures of the cached dista
 extern long *CostMatrix;        /* The cost matrix */
 extern double BetterCost;       /* The cost of the tour stored in BetterTour */
 extern double LowerBound;       /* The lower bound found by the ascent */
-extern unsigned long Hash;      /* The hash value corresponding to the current tour */
+extern double CurrentCost;      /* The (scaled) cost of the tour left by the last 
+                                   trial */
+extern __thread unsigned long Hash;
+                                /* The hash value corresponding to the current tour */
 extern int *Rand;               /* A table of random values */
-extern int Reversed;            /* A boolean used to indicate whether a tour has been
-                                   reversed */
+extern __thread int Reversed;   /* A boolean used to indicate whether a tour has been
+                                   reversed (one for each thread) */
+extern __thread int WorkerThread;
+                                /* A boolean used to indicate that the current thread
+                                   is a worker thread, which must neither change the 
+                                   tour nor update the distance cache */
 extern Segment *FirstSegment;   /* A pointer to the first segment in the cyclic list of 
                                    segments */
 extern HashTable *HTable;       /* The hash table used for storing tours */
@@ -251,7 +327,13 @@ extern FILE *ParameterFile, *ProblemFile, *PiFile, *TourFile, *OutputFile,
             *MergeTourFile[2];
 extern char *ParameterFileName, *ProblemFileName, *PiFileName, *TourFileName, *OutputFileName,
             *InputTourFileName, *CandidateFileName, *InitialTourFileName,
+            *CheckpointFileName, *BatchFileName, *BatchResultFileName,
+            *ServerName, *SweepFileName, *AutoTuneFileName,
+            *AutoTuneResultFileName, *PortfolioFileName,
             *MergeTourFileName[2];
+extern char *ProblemData;       /* If not 0, the text of the problem, which is
+                                   then read from memory instead of from
+                                   PROBLEM_FILE */
 extern char *Name, *Type, *EdgeWeightType, *EdgeWeightFormat, 
             *EdgeDataFormat, *NodeCoordType, *DisplayDataType;
 extern int ProblemType, WeightType, WeightFormat, CoordType, CandidateSetSymmetric;
@@ -260,6 +342,7 @@ extern int ProblemType, WeightType, WeightFormat, CoordType, CandidateSetSymmetr
 SwapMove *CreateSwapMove(int id, long gain);
 SwapMove* CreateSwapMoveTree(int maxDepth, int maxChildren, long gain);
 SwapMove *CreateSwapMoveAlloc(int id, Node *t1, Node *t2, Node *t3, Node *t4, long gain, SwapMove *parent);
+void FreeSwapMove(SwapMove **root);
 
 extern long (*Distance) (Node *Na, Node *Nb);
 long Distance_1(Node *Na, Node *Nb);
@@ -297,6 +380,10 @@ long c_GEOM(Node *Na, Node *Nb);
 
 void SwNeighborhood2Opt(Node *t1, Node *t2, long *G0, SwapMove *parent, int depth, ExcludedEdges *edges);
 SwapMove* SwNeighborhoodBreadth(SwapMove *currentMove);
+SwapMove *SwNeighborhoodParallel(SwapMove *Root);
+SwapMove *SwNeighborhoodBeam(SwapMove *Root);
+void StartSwWorkers();
+void RecordSwaps();
 double GenerateRandomNonZero();
 int NotExcludable(ExcludedEdges *head, long first, long second);
 void SetSwapMove(SwapMove **move, Node *t1, Node *t2, Node *t3, Node *t4, long gain, long g2Gain);
@@ -304,10 +391,15 @@ void ExcludeEdge(ExcludedEdges **head, int first, int second);
 void RestoreMovement(Node **T1, Node **T2, Node **T3, Node *t1, Node *t2);
 void DisExcludLastEdges(ExcludedEdges **head);
 void ShiftToEnd(int *tab, int n, int index);
+void StartSampler(CandidateSampler *S, int Count);
+int NextSample(CandidateSampler *S);
 int GetDistanceFromRoot(SwapMove* node);
 void ReInitSwaps(SwapMove *swapMove);
+void VirtualSwaps(SwapMove *swapMove);
 void ApplyMoves(SwapMove **pathToRoot, int pathLength);
 SwapMove **FindPathToRoot(SwapMove *move, int *pathLength);
+void ResetIsActive(SwapMove **root);
+int CountSwapMoveTreeNodes(SwapMove *root);
 
 extern Node* (*BestMove) (Node *t1, Node *t2, long *G0, long *Gain);
 Node *Best2OptMove(Node *t1, Node *t2, long *G0, long *Gain);
@@ -333,6 +425,13 @@ long BridgeGain(Node *s1, Node *s2, Node *s3, Node *s4,
                 int Case6, long G);
 void ChooseInitialTour();
 void Connect(Node * N1, const long Max, const int Sparse);
+void CloneNodes(Node **Clone, Candidate **CandidateSet,
+                long *CandidateSpace);
+void MarkChanged(Node *N);
+void MarkAllChanged();
+void UpdateClone(Node *Clone);
+long ClearChanged();
+int CloneIsCurrent(long Epoch);
 void CreateCandidateSet();
 void eprintf(char *fmt, ...);
 int Excludable(const Node *Na, const Node *Nb);
@@ -344,10 +443,13 @@ void Flip_SL(Node *t1, Node *t2, Node *t3);
 int Forbidden(const Node * ta, const Node * tb);
 void FreeStructures();
 long Gain23();
+double InitializeTrial();
 void GenerateCandidates(const long MaxCandidates, const long MaxAlpha, const int Symmetric);
 double GetTime();
+double GetWallTime();
 double LinKernighan();
 double LinKernighanSW();
+double LinKernighanParallel();
 void Make2OptMove(Node *t1, Node *t2, Node *t3, Node *t4);
 void Make3OptMove(Node *t1, Node *t2, Node *t3, Node *t4, 
                   Node *t5, Node *t6, int Case);
@@ -361,19 +463,84 @@ double Minimum1TreeCost(const int Sparse);
 void MinimumSpanningTree(const int Sparse);
 void NormalizeNodeList();
 void PrintBestTour();
+void FlushBestTour();
+int ReadCheckpoint(long *Run, long *TrialSum, long *MinTrial,
+                   long *Successes, double *CostSum, double *TimeSum,
+                   double *MinTime);
+void WriteCheckpoint(long Run, long TrialSum, long MinTrial,
+                     long Successes, double CostSum, double TimeSum,
+                     double MinTime, int Force);
+void ReadState(FILE *File, char *Source, long *Run, long *TrialSum,
+               long *MinTrial, long *Successes, double *CostSum,
+               double *TimeSum, double *MinTime);
+void WriteState(FILE *File, long Run, long TrialSum, long MinTrial,
+                long Successes, double CostSum, double TimeSum,
+                double MinTime);
+int RestorePreprocessing(long *Run, long *TrialSum, long *MinTrial,
+                         long *Successes, double *CostSum, double *TimeSum,
+                         double *MinTime);
+void SavePreprocessing(long Run, long TrialSum, long MinTrial,
+                       long Successes, double CostSum, double TimeSum,
+                       double MinTime);
 void PrintParameters();
 unsigned Random();
 void ReadTour(char *FileName, FILE **File);
+void ReadInitialTours();
+void SetInitialTour(long Run);
+void OverrideInitialTours();
+int ReadSweepConfiguration(char **Label);
+void TruncateCandidateSets(long MaxCandidates);
+char **ReadConfigurations(char *FileName, long *Count);
+char *ApplyConfiguration(char *Configuration);
+void ReadProblemData();
+void AutoTune();
+void Portfolio();
+void PublishIncumbent(double Cost);
+double AdoptIncumbent(double Cost);
+void DetachIncumbent();
+void StoreMergeTour(double Cost);
+double MergeTours();
+void ClearMergeTours();
+double PartitionCrossover(double Cost);
+void ClearCrossover();
+void CollectBackbone(long Run);
+long CollapsePaths();
+void AddCandidate(Node *From, Node *To, long Cost);
+void MultiLevel();
+double SolveSubproblems();
+int SolveSubproblem(char *Data);
+void SolvePartitions();
 char *ReadLine(FILE *InputFile);
 void ReadParameters();
+int ReadBatchInstance();
+int ReadParameter(char *Line);
+void ResetParameters();
+void Serve();
+void Solve(FILE *ResultFile, char *Label);
 void ReadProblem();
 void RecordBestTour();
 void RecordBetterTour();
 Node *RemoveFirstActive();
 void ResetCandidateSet();
 void RestoreTour();
+void SegmentDoubleBridgeKick();
+void KickSwap(Node *t1, Node *t2, Node *t3);
+void LogSwaps();
+int RestoreBestTour();
+Node *RemoveMovedNode();
+void ClearTrialLog();
+int TrialLogValid();
+void ValidateTrialLog();
+void InvalidateTrialLog();
 void StoreTour(int activate);
+void Touch(Node *t);
+void ResetVirtualTour(Node *Origin);
+void VirtualFlip(Node *t1, Node *t2, Node *t3, Node *t4);
+Node *VirtualSUC(Node *a);
+Node *VirtualPRED(Node *a);
+int VirtualBETWEEN(Node *a, Node *b, Node *c);
 void SRandom(unsigned Seed);
+void RandomJump();
 
 #endif
 
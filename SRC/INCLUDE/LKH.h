@@ -0,0 +1,61 @@
+#ifndef _LKH_H
+#define _LKH_H
+
+/*
+   This header is the interface of the library (liblkh), which embeds the
+   solver in another program. A problem is given by in-memory arrays, and
+   the tour is returned in memory. No files are needed.
+
+   The solver is not reentrant: the library may be called by only one
+   thread at a time. Output (the trace of the solver) is written to
+   standard output, as by the program; use TRACE_LEVEL = 0 to reduce it.
+*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A problem */
+typedef struct LKH_Problem {
+    int Dimension;              /* The number of nodes */
+    const double *X, *Y;        /* The coordinates of the nodes, or 0 */
+    const char *EdgeWeightType; /* The distance function for coordinates,
+                                   as in TSPLIB (0 = EUC_2D) */
+    const long *Weights;        /* The full weight matrix (row by row,
+                                   Dimension x Dimension), or 0 */
+    int Asymmetric;             /* Nonzero if Weights is asymmetric (ATSP) */
+} LKH_Problem;
+
+/* The result of solving a problem */
+typedef struct LKH_Result {
+    int *Tour;                  /* The best tour, as Dimension node indices
+                                   (0-based) */
+    int Dimension;              /* The number of nodes of the tour */
+    double Cost;                /* The cost of the tour */
+    double LowerBound;          /* The lower bound found by the ascent */
+} LKH_Result;
+
+/* Called with each new best tour (as in LKH_Result) */
+typedef void (*LKH_ProgressFunction)(double Cost, const int *Tour,
+                                     int Dimension, void *UserData);
+
+/*
+   The LKH_Solve function solves a problem. Parameters is a list of
+   parameter settings in the format of the parameter file (for example,
+   "RUNS = 1" or "MAX_TRIALS = 1000"), terminated by 0. Progress, if not 0,
+   is called with each new best tour. On success, 0 is returned, and the
+   tour is stored in Result. It must be released by LKH_FreeResult.
+   Otherwise, -1 is returned, and LKH_ErrorMessage returns the message.
+*/
+
+int LKH_Solve(const LKH_Problem * Problem, const char *const *Parameters,
+              LKH_ProgressFunction Progress, void *UserData,
+              LKH_Result * Result);
+void LKH_FreeResult(LKH_Result * Result);
+const char *LKH_ErrorMessage(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
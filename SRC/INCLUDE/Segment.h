@@ -20,6 +20,12 @@
            in the tour with respect to a chosen orientation (BETWEEN);
 
        (4) make a 2-opt move (FLIP).
+
+   In addition, POSITION gives the ordinal number of a node in the tour, as
+   used by the Gain23 and BridgeGain functions. With the two-level tree
+   representation it is the V field, which is numbered by Gain23. With the 
+   linked list representation it is the Rank field, which is maintained by 
+   Flip.
 	
    The default representation is the two-level tree representation. 
    In order to use the linked list representation, uncomment the 
@@ -33,14 +39,16 @@
 #define SUC(a) (Reversed == (a)->Parent->Reversed ? (a)->Suc : (a)->Pred)
 #define BETWEEN(a,b,c) Between_SL(a,b,c)
 #define FLIP(a,b,c,d) Flip_SL(a,b,c)
+#define POSITION(a) ((a)->V)
 #else
 #define PRED(a) (Reversed ? (a)->Suc : (a)->Pred)
 #define SUC(a) (Reversed ? (a)->Pred : (a)->Suc)
 #define BETWEEN(a,b,c) Between(a,b,c)
 #define FLIP(a,b,c,d) Flip(a,b,c)
+#define POSITION(a) ((a)->Rank)
 #endif
 
-extern int Reversed;
+extern __thread int Reversed;
 
 #define Swap1(a1,a2,a3)\
         FLIP(a1,a2,a3,0)
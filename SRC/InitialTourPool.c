@@ -0,0 +1,214 @@
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <sys/stat.h>
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file maintain the pool of initial tours, one for
+   each run.
+
+   The ReadInitialTours function reads all initial tours once, before the
+   first run. They are read from the file or directory specified by
+   INITIAL_TOUR_FILE. Each tour is stored as a compact array of node
+   numbers (int).
+
+   (1) If INITIAL_TOUR_FILE is a directory, each regular file in the
+       directory is read. The files are taken in natural order (for
+       example, "x_input_2" before "x_input_10").
+
+   (2) Otherwise the file is read. It may contain several tours, each
+       given by a TOUR_SECTION terminated by -1 (for example, several
+       TSPLIB tour files concatenated).
+
+   (3) If the file contains a single tour and its name contains
+       "_input_<n>", the files with the same name, but with the numbers
+       n+1, n+2, ..., are also read, as long as they exist and there is no
+       more than one tour per run.
+
+   The SetInitialTour function sets the InitialSuc fields of the nodes to
+   the initial tour of a given run. Run number r (r >= 1) uses tour number
+   (r - 1) % PoolSize + 1.
+
+   The OverrideInitialTours function is called when the solver itself has
+   set the InitialSuc fields to a better tour than those of the pool (the
+   stitched tour of SolvePartitions, or the tour found by MultiLevel).
+   SetInitialTour then leaves the InitialSuc fields unchanged, so that
+   every run starts from that tour.
+*/
+
+static int **Pool = 0;          /* The tours of the pool */
+static int PoolSize = 0;        /* The number of tours in the pool */
+static int PoolCapacity = 0;
+static int TourLength;          /* The number of node numbers in a tour */
+static char *Mark = 0;          /* Used for checking the tours */
+static int Overridden = 0;      /* 1, if the pool is not to be used */
+
+static const char Delimiters[] = " :=\n\t\r\f\v";
+
+static int ReadTours(char *FileName);
+static int CompareNames(const void *Na, const void *Nb);
+
+void ReadInitialTours()
+{
+    struct stat Status;
+    struct dirent *Entry;
+    DIR *Dir;
+    char **Names = 0, *Digits, *Rest, *FileName;
+    int Count = 0, Capacity = 0, i, n;
+    FILE *File;
+
+    /* Free the tours of a previous problem */
+    while (PoolSize > 0)
+        free(Pool[--PoolSize]);
+    Overridden = 0;
+    if (InitialTourFileName == 0)
+        return;
+    TourLength = ProblemType == ATSP ? Dimension / 2 :
+        ProblemType == HPP ? Dimension - 1 : Dimension;
+    assert(Mark = (char *) calloc(Dimension + 1, sizeof(char)));
+    if (stat(InitialTourFileName, &Status))
+        eprintf("Cannot open %s", InitialTourFileName);
+    if (S_ISDIR(Status.st_mode)) {
+        if (!(Dir = opendir(InitialTourFileName)))
+            eprintf("Cannot open %s", InitialTourFileName);
+        while ((Entry = readdir(Dir))) {
+            if (Entry->d_name[0] == '.')
+                continue;
+            assert(FileName = (char *)
+                   malloc(strlen(InitialTourFileName) +
+                          strlen(Entry->d_name) + 2));
+            sprintf(FileName, "%s/%s", InitialTourFileName, Entry->d_name);
+            if (stat(FileName, &Status) || !S_ISREG(Status.st_mode)) {
+                free(FileName);
+                continue;
+            }
+            if (Count == Capacity)
+                assert(Names = (char **)
+                       realloc(Names,
+                               (Capacity = 2 * Capacity + 8) *
+                               sizeof(char *)));
+            Names[Count++] = FileName;
+        }
+        closedir(Dir);
+        qsort(Names, Count, sizeof(char *), CompareNames);
+        for (i = 0; i < Count; i++) {
+            ReadTours(Names[i]);
+            free(Names[i]);
+        }
+        free(Names);
+    } else if (ReadTours(InitialTourFileName) == 1 &&
+               (Digits = strstr(InitialTourFileName, "_input_")) &&
+               sscanf(Digits += strlen("_input_"), "%d", &n) == 1) {
+        for (Rest = Digits; isdigit((unsigned char) *Rest); Rest++);
+        assert(FileName = (char *)
+               malloc(strlen(InitialTourFileName) + 24));
+        while (PoolSize < Runs) {
+            sprintf(FileName, "%.*s%d%s", (int) (Digits -
+                                                 InitialTourFileName),
+                    InitialTourFileName, ++n, Rest);
+            if (!(File = fopen(FileName, "r")))
+                break;
+            fclose(File);
+            ReadTours(FileName);
+        }
+        free(FileName);
+    }
+    if (PoolSize == 0)
+        eprintf("INITIAL_TOUR_FILE: No tours in %s", InitialTourFileName);
+    free(Mark);
+    Mark = 0;
+}
+
+void SetInitialTour(long Run)
+{
+    int *Tour, i;
+    Node *First, *Last, *N;
+
+    if (PoolSize == 0 || Overridden)
+        return;
+    Tour = Pool[(Run - 1) % PoolSize];
+    N = FirstNode;
+    do
+        N->InitialSuc = 0;
+    while ((N = N->Suc) != FirstNode);
+    First = Last = 0;
+    for (i = 0; i < TourLength; i++) {
+        N = &NodeSet[Tour[i]];
+        if (Last)
+            Last->InitialSuc = N;
+        else
+            First = N;
+        Last = N;
+        if (ProblemType == ATSP) {
+            N = &NodeSet[Tour[i] + Dimension / 2];
+            Last->InitialSuc = N;
+            Last = N;
+        }
+    }
+    Last->InitialSuc = First;
+}
+
+void OverrideInitialTours()
+{
+    Overridden = 1;
+}
+
+/*
+   The ReadTours function adds the tours of a file to the pool and returns
+   their number.
+*/
+
+static int ReadTours(char *FileName)
+{
+    FILE *File;
+    char *Line, *Keyword;
+    int Tours = 0, *Tour, i;
+    long Id;
+
+    if (!(File = fopen(FileName, "r")))
+        eprintf("Cannot open %s", FileName);
+    while ((Line = ReadLine(File))) {
+        if (!(Keyword = strtok(Line, Delimiters)))
+            continue;
+        for (i = 0; i < strlen(Keyword); i++)
+            Keyword[i] = (char) toupper(Keyword[i]);
+        if (!strcmp(Keyword, "OPTIMUM")) {
+            if (!(Keyword = strtok(0, Delimiters)) ||
+                !sscanf(Keyword, "%lf", &Optimum))
+                eprintf("(OPTIMUM): real expected");
+            Optimum = floor(Optimum + 0.5);
+            continue;
+        }
+        if (strcmp(Keyword, "TOUR_SECTION"))
+            continue;
+        assert(Tour = (int *) malloc(TourLength * sizeof(int)));
+        memset(Mark, 0, Dimension + 1);
+        for (i = 0; fscanf(File, "%ld", &Id) == 1 && Id != -1; i++) {
+            if (i == TourLength)
+                eprintf("%s: Too many nodes in tour", FileName);
+            if (Id <= 0 || Id > TourLength)
+                eprintf("(TOUR_SECTION) Node number out of range: %ld",
+                        Id);
+            if (Mark[Id])
+                eprintf("(TOUR_SECTION) Node number occours twice: %ld",
+                        Id);
+            Mark[Id] = 1;
+            Tour[i] = (int) Id;
+        }
+        if (i < TourLength)
+            eprintf("%s: Too few nodes in tour", FileName);
+        if (PoolSize == PoolCapacity)
+            assert(Pool = (int **)
+                   realloc(Pool, (PoolCapacity = 2 * PoolCapacity + 8) *
+                           sizeof(int *)));
+        Pool[PoolSize++] = Tour;
+        Tours++;
+    }
+    fclose(File);
+    return Tours;
+}
+
+static int CompareNames(const void *Na, const void *Nb)
+{
+    return strverscmp(*(char **) Na, *(char **) Nb);
+}
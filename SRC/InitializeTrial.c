@@ -0,0 +1,144 @@
+#include "INCLUDE/Segment.h"
+#include "INCLUDE/LK.h"
+
+/*
+   The InitializeTrial function prepares the current tour for a trial of
+   the LinKernighan or LinKernighanSW function. It returns the cost of the
+   tour.
+
+   The function computes the cost of the tour and the corresponding hash
+   value, Hash. For each node it sets Rank (its ordinal number in the tour),
+   OldPred and OldSuc (its neighbors in the starting tour of the trial),
+   and Cost (its minimum cost of candidate edges not on the tour). Nodes are
+   made "active" (so that they can be used as t1). When the trial starts from
+   a kicked tour, only nodes with an incident edge not in the currently best
+   tour are made active.
+
+   A full initialization visits all nodes and all candidate edges. When the
+   trial starts from a kicked tour (KICK_TYPE = SEGMENT_DOUBLE_BRIDGE and
+   Trial > 1), only the nodes whose tour neighbors may have changed since
+   the previous trial are visited: the end nodes of the 2-opt moves that
+   restored the best tour and made the kick (see RemoveMovedNode). The
+   state left by the previous trial is reused for all other nodes: OldPred
+   and OldSuc still give the tour at the end of that trial, and its cost
+   is given by CurrentCost. Rank and Hash have already been maintained by
+   Flip. For each visited node whose neighbors differ from OldPred and
+   OldSuc, the cost is updated with the edges that have been removed and
+   added (each such edge is accounted for at its end node with the
+   smallest Id), and its Cost is recomputed. The visited nodes with an
+   incident edge not in the best tour are made active. Every other node
+   has kept its edges since the best tour was recorded, so both are in
+   the best tour, and it is left inactive. Thus, the time of an incremental initialization
+   depends on the changes of the tour only (see RestoreBestTour).
+
+   Nodes whose tour neighbors may have changed since the previous trial are
+   "touched" (see the Touch function): all nodes in a full initialization,
+   and the nodes with changed neighbors in an incremental one. The same
+   nodes are marked for the worker threads (see MarkChanged); a full
+   initialization marks all nodes (see MarkAllChanged).
+
+   The incremental initialization presumes the doubly linked list
+   representation of tours; the segment list is not rebuilt. It is only
+   used if the previous initialization was made for the tour changed by
+   the logged 2-opt moves (see ValidateTrialLog).
+*/
+
+static void UpdateCost(Node * t);
+
+double InitializeTrial()
+{
+    Node *t1, *t2, *u;
+    Segment *S;
+    double Cost;
+    long i;
+    int X2;
+
+    Reversed = 0;
+    Swaps = 0;
+    i = 0;
+#ifndef SEGMENT_LIST
+    if (KickType == SEGMENT_DOUBLE_BRIDGE && Trial > 1 && TrialLogValid()) {
+        while (RemoveFirstActive());
+        Cost = CurrentCost;
+        while ((t1 = RemoveMovedNode())) {
+            if ((t1->Pred != t1->OldPred || t1->Suc != t1->OldSuc) &&
+                (t1->Pred != t1->OldSuc || t1->Suc != t1->OldPred)) {
+                /* Remove edges no longer on the tour */
+                for (X2 = 1; X2 <= 2; X2++) {
+                    u = X2 == 1 ? t1->OldPred : t1->OldSuc;
+                    if (u != t1->Pred && u != t1->Suc && t1->Id < u->Id)
+                        Cost -= C(t1, u) - t1->Pi - u->Pi;
+                }
+                /* Add edges new to the tour */
+                for (X2 = 1; X2 <= 2; X2++) {
+                    u = X2 == 1 ? t1->Pred : t1->Suc;
+                    if (u != t1->OldPred && u != t1->OldSuc &&
+                        t1->Id < u->Id)
+                        Cost += C(t1, u) - t1->Pi - u->Pi;
+                }
+                t1->OldPred = t1->Pred;
+                t1->OldSuc = t1->Suc;
+                UpdateCost(t1);
+                Touch(t1);
+                MarkChanged(t1);
+            }
+            t1->OldPredExcluded = t1->OldSucExcluded = 0;
+            if (!InBestTour(t1, t1->Pred) || !InBestTour(t1, t1->Suc))
+                Activate(t1);
+        }
+        return CurrentCost = Cost;
+    }
+#endif
+    MarkAllChanged();
+    ValidateTrialLog();
+    S = FirstSegment;
+    do {
+        S->Size = 0;
+        S->Rank = ++i;
+        S->Reversed = 0;
+        S->First = S->Last = 0;
+    } while ((S = S->Suc) != FirstSegment);
+    i = 0;
+    Hash = 0;
+    FirstActive = LastActive = 0;
+    Cost = 0;
+    t1 = FirstNode;
+    do {
+        t2 = t1->OldSuc = t1->Suc;
+        t1->OldPred = t1->Pred;
+        t1->Rank = ++i;
+        Cost += C(t1, t2) - t1->Pi - t2->Pi;
+        Hash ^= Rand[t1->Id] * Rand[t2->Id];
+        UpdateCost(t1);
+        Touch(t1);
+        t1->Parent = S;
+        S->Size++;
+        if (S->Size == 1)
+            S->First = t1;
+        S->Last = t1;
+        if (S->Size == GroupSize)
+            S = S->Suc;
+        t1->OldPredExcluded = t1->OldSucExcluded = 0;
+        t1->Next = 0;
+        if (KickType == RANDOM_RESTART ||
+            !InBestTour(t1, t1->Pred) || !InBestTour(t1, t1->Suc))
+            Activate(t1);
+    } while ((t1 = t1->Suc) != FirstNode);
+    return CurrentCost = Cost;
+}
+
+/*
+   The UpdateCost function computes the minimum cost of candidate edges
+   emanating from t that are not on the tour.
+*/
+
+static void UpdateCost(Node * t)
+{
+    Candidate *Nt;
+    Node *u;
+
+    t->Cost = LONG_MAX;
+    for (Nt = t->CandidateSet; (u = Nt->To); Nt++)
+        if (u != t->Pred && u != t->Suc && Nt->Cost < t->Cost)
+            t->Cost = Nt->Cost;
+}
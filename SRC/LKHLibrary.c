@@ -0,0 +1,134 @@
+#include "INCLUDE/LK.h"
+#include "INCLUDE/LKH.h"
+
+/*
+   This file contains the functions of the library interface (see LKH.h).
+
+   LKH_Solve sets the parameters to their defaults, overridden by the
+   given settings, and formats the problem in TSPLIB format in memory
+   (ProblemData), which is then read by ReadProblem as usual. Then the
+   problem is solved by Solve. Errors (reported by eprintf) return to
+   LKH_Solve instead of terminating the program.
+*/
+
+static LKH_ProgressFunction UserProgress;
+static void *UserData;
+static int *ProgressTour = 0;
+static char *Data = 0;          /* The problem in TSPLIB format */
+static size_t DataSize;
+static char *Line = 0;          /* A copy of a parameter setting */
+
+static int *CopyTour(int *Tour, int *Dim);
+static void Progress(double Cost);
+
+int LKH_Solve(const LKH_Problem * Problem, const char *const *Parameters,
+              LKH_ProgressFunction Callback, void *CallbackData,
+              LKH_Result * Result)
+{
+    jmp_buf Return;
+    FILE *Text;
+    int i, j, n = Problem->Dimension;
+
+    Result->Tour = 0;
+    Result->Dimension = 0;
+    ErrorMessage[0] = '\0';
+    ErrorReturn = &Return;
+    if (setjmp(Return)) {
+        ErrorReturn = 0;
+        TourCallback = 0;
+        FlushBestTour();
+        ProblemData = 0;
+        return -1;
+    }
+    if (n < 3 || (!Problem->Weights && (!Problem->X || !Problem->Y)))
+        eprintf("LKH_Solve: Invalid problem");
+    ResetParameters();
+    for (; Parameters && *Parameters; Parameters++) {
+        assert(Line = (char *) realloc(Line, strlen(*Parameters) + 1));
+        strcpy(Line, *Parameters);
+        ReadParameter(Line);
+    }
+    free(ProblemFileName);
+    assert(ProblemFileName = (char *) malloc(2));
+    strcpy(ProblemFileName, "-");
+
+    /* Format the problem */
+    free(Data);
+    Data = 0;
+    if (!(Text = open_memstream(&Data, &DataSize)))
+        eprintf("LKH_Solve: Out of memory");
+    fprintf(Text, "NAME : LKH_Problem\nTYPE : %s\nDIMENSION : %d\n",
+            Problem->Weights && Problem->Asymmetric ? "ATSP" : "TSP", n);
+    if (Problem->Weights) {
+        fprintf(Text, "EDGE_WEIGHT_TYPE : EXPLICIT\n"
+                "EDGE_WEIGHT_FORMAT : FULL_MATRIX\nEDGE_WEIGHT_SECTION\n");
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < n; j++)
+                fprintf(Text, " %ld", Problem->Weights[(long) i * n + j]);
+            fprintf(Text, "\n");
+        }
+    } else {
+        fprintf(Text, "EDGE_WEIGHT_TYPE : %s\nNODE_COORD_SECTION\n",
+                Problem->EdgeWeightType ? Problem->EdgeWeightType :
+                "EUC_2D");
+        for (i = 0; i < n; i++)
+            fprintf(Text, "%d %.17g %.17g\n", i + 1, Problem->X[i],
+                    Problem->Y[i]);
+    }
+    fprintf(Text, "EOF\n");
+    fclose(Text);
+    ProblemData = Data;
+
+    UserProgress = Callback;
+    UserData = CallbackData;
+    TourCallback = UserProgress ? Progress : 0;
+    Solve(0, 0);
+    TourCallback = 0;
+    ErrorReturn = 0;
+    ProblemData = 0;
+
+    Result->Tour = CopyTour(0, &Result->Dimension);
+    Result->Cost = BestCost;
+    Result->LowerBound = LowerBound;
+    return 0;
+}
+
+void LKH_FreeResult(LKH_Result * Result)
+{
+    free(Result->Tour);
+    Result->Tour = 0;
+    Result->Dimension = 0;
+}
+
+const char *LKH_ErrorMessage(void)
+{
+    return ErrorMessage;
+}
+
+/*
+   The CopyTour function copies BestTour into Tour as 0-based node indices
+   and returns Tour. If Tour is 0, a new array is allocated. The number of
+   nodes is stored in *Dim.
+*/
+
+static int *CopyTour(int *Tour, int *Dim)
+{
+    int i;
+
+    *Dim = ProblemType == ATSP ? Dimension / 2 : Dimension;
+    if (!Tour)
+        assert(Tour = (int *) malloc(*Dim * sizeof(int)));
+    for (i = 0; i < *Dim; i++)
+        Tour[i] = (int) BestTour[i + 1] - 1;
+    return Tour;
+}
+
+static void Progress(double Cost)
+{
+    int Dim;
+
+    assert(ProgressTour =
+           (int *) realloc(ProgressTour, Dimension * sizeof(int)));
+    CopyTour(ProgressTour, &Dim);
+    UserProgress(Cost, ProgressTour, Dim, UserData);
+}
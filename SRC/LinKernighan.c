@@ -16,52 +16,12 @@ Node *ChooseRandomNode(Node *firstNode);
 
 double LinKernighan() {
     Node *t1, *t2, *SUCt1;
-    long Gain, G0, i;
+    long Gain, G0;
     double Cost, minimumCost;
-    Candidate *Nt1;
-    Segment *S;
     int X2, it = 0;
-    Reversed = 0;
-    S = FirstSegment;
-    i = 0;
-    do {
-        S->Size = 0;
-        S->Rank = ++i;
-        S->Reversed = 0;
-        S->First = S->Last = 0;
-    } while ((S = S->Suc) != FirstSegment);
-    i = 0;
-    Hash = 0;
-    Swaps = 0;
-    FirstActive = LastActive = 0;
-
-    /* Compute the cost of the initial tour, Cost.
-       Compute the corresponding hash value, Hash.
-       Initialize the segment list.
-       Make all nodes "active" (so that they can be used as t1). */
-    Cost = 0;
-    t1 = FirstNode;
-    do {
-        t2 = t1->OldSuc = t1->Next = t1->Suc;
-        t1->OldPred = t1->Pred;
-        t1->Rank = ++i;
-        Cost += C(t1, t2) - t1->Pi - t2->Pi;
-        Hash ^= Rand[t1->Id] * Rand[t2->Id];
-        t1->Cost = LONG_MAX;
-        for (Nt1 = t1->CandidateSet; t2 = Nt1->To; Nt1++)
-            if (t2 != t1->Pred && t2 != t1->Suc && Nt1->Cost < t1->Cost)
-                t1->Cost = Nt1->Cost;
-        t1->Parent = S;
-        S->Size++;
-        if (S->Size == 1)
-            S->First = t1;
-        S->Last = t1;
-        if (S->Size == GroupSize)
-            S = S->Suc;
-        t1->OldPredExcluded = t1->OldSucExcluded = 0;
-        t1->Next = 0;
-        Activate(t1);
-    } while ((t1 = t1->Suc) != FirstNode);
+    /* Compute the cost of the initial tour, Cost, and make the nodes
+       to be used as t1 "active" */
+    Cost = InitializeTrial();
 
     minimumCost = Cost;
     printf("Initial Cost = %0.0f", Cost / Precision);
@@ -104,12 +64,15 @@ double LinKernighan() {
                     /* Make t1 "active" again */
                     Activate(t1);
                     goto Next_t1;
-                } else {
+                } else if (KickType == RANDOM_RESTART) {
                     Activate(t1);
                 }
             }
             RestoreTour();
-            Activate(t1);
+            /* After a kick, t1 stays inactive until it takes part in 
+               an improving move */
+            if (KickType == RANDOM_RESTART)
+                Activate(t1);
         }
         Next_t1:;
     }
@@ -121,6 +84,7 @@ double LinKernighan() {
     printf(", Time = %0.0f sec.\n", fabs(GetTime() - LastTime));
 
     End_LinKernighan:
+    CurrentCost = Cost;
     NormalizeNodeList();
     return minimumCost / Precision;
 }
@@ -0,0 +1,398 @@
+#include <pthread.h>
+#include "INCLUDE/Segment.h"
+#include "INCLUDE/LK.h"
+
+/*
+   The LinKernighanParallel function is a multi-threaded version of the
+   LinKernighan function. It is used instead of LinKernighan when
+   LK_THREADS > 1.
+
+   The search proceeds in rounds. In each round the master thread (the
+   calling thread) removes up to LKThreads * TasksPerThread nodes from the
+   queue of active nodes. These nodes are tried as t1 by LKThreads worker
+   threads, each of which has a private copy of all nodes (and their
+   candidate sets). A worker evaluates t1 exactly as LinKernighan does, but
+   on its copy of the tour. If an improving move is found, the worker
+   records the 2-opt moves (swaps) of the move together with its gain, and
+   undoes the move on its copy. Thus, all t1 nodes of a round are evaluated
+   against the same tour.
+
+   When all t1 nodes of a round have been evaluated, the master commits the
+   improving moves in the order their t1 nodes were removed from the queue.
+   A move is committed by replaying its swaps on the tour. Before each swap
+   it is checked that the swap exchanges the same edges as it did on the
+   worker's copy. If so, the move produces a tour, and its gain is exactly
+   the recorded gain. Otherwise, the move conflicts with a move committed
+   earlier in the round; the swaps already replayed are undone, and t1 is
+   made active again, so that it will be tried in a later round.
+
+   At the start of the next round, each worker replays the committed moves
+   on its copy of the tour, exactly as the master made them.
+
+   The worker threads and their copies are created at the first call and
+   kept for the following trials (they are created anew for another
+   problem size or another number of threads, and in a child process
+   created by fork, which has no copies of the threads). At the start of a
+   trial, a worker replays the swaps committed at the end of the previous
+   trial and then copies the nodes that the master has changed since then
+   (see UpdateClone). Only when the master has marked all nodes as changed
+   (for example, after a better tour has been found) is the copy made anew
+   by CloneNodes.
+
+   A worker's copy holds all nodes rather than only those it changes (a
+   copy-on-write overlay of the master's tour). The evaluation of t1 reads
+   and writes Pred, Suc, Rank, the exclusion flags and Cost of arbitrary
+   nodes through the SUC, PRED, BETWEEN and Flip primitives, and
+   BestMove, Flip and the other move functions are shared with the serial
+   search. An overlay would put a lookup in each of these primitives, on
+   the hot path of the serial search as well. With a full copy, the worker
+   runs the unchanged code on its own NodeSet. The price is memory: each
+   worker holds Dimension + 1 nodes and their candidate sets (about 40 MB
+   for 100,000 nodes with 5 candidates per node), so the memory used for
+   tours grows linearly with LK_THREADS. The copies are made once and are
+   then updated incrementally, so their time cost is small.
+
+   The function returns the cost of the resulting tour.
+*/
+
+#include <unistd.h>
+
+#define TasksPerThread 8
+
+typedef struct Worker {
+    pthread_t Thread;
+    Node *NodeSet;              /* The worker's copy of the nodes */
+    Candidate *CandidateSet;    /* The worker's copy of the candidate sets */
+    long CandidateSpace;        /* The capacity of CandidateSet */
+    SwapRecord *SwapStack;      /* The worker's stack of swaps */
+    long *Log;                  /* The swaps of the worker's improving moves */
+    long LogSize, LogSpace;     /* The size and capacity of Log */
+    unsigned Seed;              /* The seed of the worker's random sequence */
+    int Stream;                 /* The number of the worker's subsequence */
+} Worker;
+
+typedef struct Task {
+    long Id;                    /* The Id of t1 */
+    Worker *W;                  /* The worker that evaluated t1 */
+    long First, Swaps;          /* The location and number of swaps in W->Log */
+    long Gain;                  /* The gain of the move (0, if no improvement) */
+} Task;
+
+static Worker *Workers = 0;
+static Task *Tasks = 0;
+static long TaskCount, NextTask;
+static long *Commits = 0;       /* The swaps committed since the workers
+                                   last replayed */
+static long CommitCount, CommitSpace;
+static long *Moves = 0;         /* The number of swaps of each committed move */
+static long MoveCount, MoveSpace;
+static int Quit;                /* 1, if the workers are to terminate */
+static int Sync;                /* 1, if the copies are to be updated */
+static int FullSync;            /* 1, if the copies are to be made anew */
+static long WorkerEpoch;        /* The epoch in which the copies were last
+                                   updated (see CloneIsCurrent) */
+static long WorkerDimension;    /* The Dimension for which Workers is allocated */
+static int WorkerCount;         /* The number of elements in Workers */
+static pid_t WorkerPid;         /* The process that created the workers */
+static pthread_mutex_t TaskMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_barrier_t Barrier;
+
+static void Evaluate(Worker * W, Task * T);
+static void *RunWorker(void *Arg);
+static void AppendSwaps(long **Log, long *Size, long *Space,
+                        SwapRecord * Stack, long Count, Node * Base);
+static int ReplaySwaps(long *Log, long Count);
+static void StartWorkers();
+static void StopWorkers();
+
+double LinKernighanParallel()
+{
+    Node *t1;
+    Task *T;
+    double Cost, minimumCost;
+    double LastTime = GetTime();
+    int i;
+
+#ifdef SEGMENT_LIST
+    return LinKernighan();
+#endif
+    /* Compute the cost of the initial tour, Cost, and make the nodes
+       to be used as t1 "active" */
+    Cost = InitializeTrial();
+    minimumCost = Cost;
+    printf("Initial Cost = %0.0f", Cost / Precision);
+    printf(" (Gap = %0.2f%%)\n",
+           100.0 * (minimumCost / Precision - Optimum) / Optimum);
+    if (HashSearch(HTable, Hash, Cost))
+        return Cost / Precision;
+
+    StartWorkers();
+    Sync = 1;
+    for (;;) {
+        TaskCount = NextTask = 0;
+        if (GetTime() - LastTime < TrialTimeBudget)
+            while (TaskCount < LKThreads * TasksPerThread &&
+                   (t1 = RemoveFirstActive()))
+                Tasks[TaskCount++].Id = t1->Id;
+        if (TaskCount == 0)
+            break;
+        for (i = 0; i < LKThreads; i++)
+            Workers[i].LogSize = 0;
+        if (Sync)
+            FullSync = !CloneIsCurrent(WorkerEpoch);
+        pthread_barrier_wait(&Barrier);
+        /* The workers update their copies and evaluate the tasks */
+        pthread_barrier_wait(&Barrier);
+        if (Sync) {
+            WorkerEpoch = ClearChanged();
+            Sync = 0;
+        }
+        CommitCount = MoveCount = 0;
+        for (T = Tasks; T < Tasks + TaskCount; T++) {
+            t1 = &NodeSet[T->Id];
+            if (T->Gain <= 0) {
+                if (KickType == RANDOM_RESTART)
+                    Activate(t1);
+                continue;
+            }
+            if (!ReplaySwaps(T->W->Log + 4 * T->First, T->Swaps)) {
+                RestoreTour();
+                Activate(t1);
+                continue;
+            }
+            /* An improvement has been found */
+            Cost -= T->Gain;
+            if (minimumCost > Cost) {
+                minimumCost = Cost;
+                if (TraceLevel >= 3 ||
+                    (TraceLevel == 2 && Cost / Precision < BetterCost)) {
+                    printf("Cost = %0.0f, Time = %0.3f sec.\n",
+                           Cost / Precision, GetTime() - LastTime);
+                    fflush(stdout);
+                }
+            }
+            AppendSwaps(&Commits, &CommitCount, &CommitSpace,
+                        SwapStack, Swaps, NodeSet);
+            if (MoveCount == MoveSpace) {
+                MoveSpace = MoveSpace ? 2 * MoveSpace : 64;
+                assert(Moves =
+                       (long *) realloc(Moves, MoveSpace * sizeof(long)));
+            }
+            Moves[MoveCount++] = Swaps;
+            StoreTour(1);
+            /* Make t1 "active" again */
+            Activate(t1);
+        }
+    }
+    printf("Cost = %0.0f", minimumCost / Precision);
+    if (Optimum != -DBL_MAX && Optimum != 0)
+        printf(", Gap = %0.2f%%",
+               100.0 * (minimumCost / Precision - Optimum) / Optimum);
+    printf(", Time = %0.0f sec.\n", fabs(GetTime() - LastTime));
+
+    CurrentCost = Cost;
+    NormalizeNodeList();
+    return minimumCost / Precision;
+}
+
+/*
+   The RunWorker function is executed by each worker thread.
+*/
+
+static void *RunWorker(void *Arg)
+{
+    Worker *W = (Worker *) Arg;
+    Node *N;
+    Task *T;
+    long i, k, Last;
+
+    WorkerThread = 1;
+    Reversed = 0;
+    SwapStack = W->SwapStack;
+    Swaps = 0;
+    SRandom(W->Seed);
+    for (k = 0; k < W->Stream; k++)
+        RandomJump();
+    for (;;) {
+        pthread_barrier_wait(&Barrier);
+        if (Quit)
+            break;
+        if (Sync && FullSync)
+            CloneNodes(&W->NodeSet, &W->CandidateSet, &W->CandidateSpace);
+        else {
+            /* Replay the moves committed since the last round */
+            N = W->NodeSet;
+            for (i = k = 0; i < MoveCount; i++) {
+                for (Last = k + Moves[i]; k < Last; k++)
+                    Swap1(&N[Commits[4 * k]], &N[Commits[4 * k + 1]],
+                          &N[Commits[4 * k + 2]]);
+                StoreTour(0);
+            }
+            if (Sync)
+                UpdateClone(W->NodeSet);
+        }
+        for (;;) {
+            pthread_mutex_lock(&TaskMutex);
+            T = NextTask < TaskCount ? &Tasks[NextTask++] : 0;
+            pthread_mutex_unlock(&TaskMutex);
+            if (!T)
+                break;
+            Evaluate(W, T);
+        }
+        pthread_barrier_wait(&Barrier);
+    }
+    return 0;
+}
+
+/*
+   The Evaluate function tries the node with Id T->Id as t1 on the worker's
+   copy of the tour, as done in LinKernighan. If an improving move is found,
+   its swaps are appended to the worker's log, and the move is undone.
+*/
+
+static void Evaluate(Worker * W, Task * T)
+{
+    Node *t1 = &W->NodeSet[T->Id], *t2, *SUCt1;
+    long Gain, G0;
+    int X2;
+
+    T->W = W;
+    T->Gain = 0;
+    SUCt1 = SUC(t1);
+    /* Choose t2 as one of t1's two neighbor nodes on the tour */
+    for (X2 = 1; X2 <= 2; X2++) {
+        t2 = X2 == 1 ? PRED(t1) : SUCt1;
+        if ((RestrictedSearch && Near(t1, t2)) || Fixed(t1, t2))
+            continue;
+        G0 = C(t1, t2);
+        /* Make sequential moves */
+        while ((t2 = BacktrackMove ?
+                BacktrackMove(t1, t2, &G0, &Gain) :
+                BestMove(t1, t2, &G0, &Gain))) {
+            if (Gain > 0) {
+                T->Gain = Gain;
+                T->First = W->LogSize;
+                T->Swaps = Swaps;
+                AppendSwaps(&W->Log, &W->LogSize, &W->LogSpace,
+                            SwapStack, Swaps, W->NodeSet);
+                RestoreTour();
+                return;
+            }
+        }
+        RestoreTour();
+    }
+}
+
+/*
+   The ReplaySwaps function makes the Count swaps given in Log (as node Ids)
+   on the tour. Before each swap it checks that the swap exchanges the same
+   edges as when it was recorded. If not, the function returns 0 (the swaps
+   made so far remain on SwapStack). Otherwise, it returns 1.
+*/
+
+static int ReplaySwaps(long *Log, long Count)
+{
+    Node *t1, *t2, *t3, *t4;
+
+    for (; Count > 0; Count--, Log += 4) {
+        t1 = &NodeSet[Log[0]];
+        t2 = &NodeSet[Log[1]];
+        t3 = &NodeSet[Log[2]];
+        t4 = &NodeSet[Log[3]];
+        if ((t1->Suc != t2 && t1->Pred != t2) ||
+            t3 == t2->Pred || t3 == t2->Suc ||
+            (t1->Suc == t2 ? t3->Pred : t3->Suc) != t4)
+            return 0;
+        Swap1(t1, t2, t3);
+    }
+    return 1;
+}
+
+/*
+   The AppendSwaps function appends the Count swaps of Stack to Log (as node
+   Ids relative to Base). The capacity of Log is enlarged as needed.
+*/
+
+static void AppendSwaps(long **Log, long *Size, long *Space,
+                        SwapRecord * Stack, long Count, Node * Base)
+{
+    long *L;
+
+    if (4 * (*Size + Count) > *Space) {
+        *Space = 2 * (4 * (*Size + Count));
+        assert(*Log = (long *) realloc(*Log, *Space * sizeof(long)));
+    }
+    for (L = *Log + 4 * *Size; Count > 0; Count--, Stack++, (*Size)++) {
+        *L++ = Stack->t1 - Base;
+        *L++ = Stack->t2 - Base;
+        *L++ = Stack->t3 - Base;
+        *L++ = Stack->t4 - Base;
+    }
+}
+
+/*
+   The StartWorkers function creates the worker threads, unless they exist
+   already for the current problem size and number of threads.
+*/
+
+static void StartWorkers()
+{
+    unsigned StreamSeed;
+    int i;
+
+    if (Workers && WorkerPid != getpid())
+        /* Inherited from the parent process; the threads do not exist */
+        Workers = 0;
+    if (Workers &&
+        (WorkerDimension != Dimension || WorkerCount != LKThreads))
+        StopWorkers();
+    if (Workers)
+        return;
+    WorkerDimension = Dimension;
+    WorkerCount = LKThreads;
+    WorkerPid = getpid();
+    WorkerEpoch = 0;
+    assert(Workers = (Worker *) calloc(LKThreads, sizeof(Worker)));
+    for (i = 0; i < LKThreads; i++)
+        assert(Workers[i].SwapStack =
+               (SwapRecord *) malloc((Dimension + 10) *
+                                     sizeof(SwapRecord)));
+    assert(Tasks =
+           (Task *) malloc(LKThreads * TasksPerThread * sizeof(Task)));
+    Quit = 0;
+    CommitCount = MoveCount = 0;
+    pthread_barrier_init(&Barrier, 0, LKThreads + 1);
+    StreamSeed = Random();
+    for (i = 0; i < LKThreads; i++) {
+        Workers[i].Seed = StreamSeed;
+        Workers[i].Stream = i + 1;
+        if (pthread_create(&Workers[i].Thread, 0, RunWorker, &Workers[i]))
+            eprintf("LinKernighanParallel: Cannot create thread");
+    }
+}
+
+/*
+   The StopWorkers function terminates the worker threads and frees the
+   workers and their copies of the nodes. It is called when the workers
+   were created for another problem size (or another number of threads).
+*/
+
+static void StopWorkers()
+{
+    int i;
+
+    Quit = 1;
+    pthread_barrier_wait(&Barrier);
+    for (i = 0; i < WorkerCount; i++) {
+        pthread_join(Workers[i].Thread, 0);
+        free(Workers[i].NodeSet);
+        free(Workers[i].CandidateSet);
+        free(Workers[i].SwapStack);
+        free(Workers[i].Log);
+    }
+    pthread_barrier_destroy(&Barrier);
+    free(Workers);
+    Workers = 0;
+    free(Tasks);
+    Tasks = 0;
+}
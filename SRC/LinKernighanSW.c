@@ -2,8 +2,6 @@
 #include "INCLUDE/Segment.h"
 #include "INCLUDE/LK.h"
 
-void FreeSwapMove(SwapMove **root);
-
 Neighborhood *CreateTree(SwapMove *tree);
 
 void ApplyMovement(SwapMove *swapMove);
@@ -18,71 +16,29 @@ SwapMove *GetRandomSwapMove(Neighborhood *listHead);
 
 void FreeNeighborhood(Neighborhood **hood);
 
-int CountSwapMoveTreeNodes(SwapMove *root);
-
-void ResetIsActive(SwapMove **root);
-
 SwapMove **StoreNegativeMove(SwapMove *move, int *size);
 
 void FreeNegativeMove(SwapMove **pathArray, int size);
 
 double LinKernighanSW() {
     Node *t1, *t2, *SUCt1;
-    long Gain, G0, i, BestNegativeGain;
+    long Gain, G0, BestNegativeGain;
     double Cost, minimumCost;
     SwapMove *pathArray[MaxDepth];
     int pathNegativeMoveSize;
-    Candidate *Nt1;
-    Segment *S;
     int X2, it = 0;
     double LastTime = GetTime();
     double startTime = GetTime();
     int positiveGainAppliyed;
 
-    Reversed = 0;
-    S = FirstSegment;
-    i = 0;
-    do {
-        S->Size = 0;
-        S->Rank = ++i;
-        S->Reversed = 0;
-        S->First = S->Last = 0;
-    } while ((S = S->Suc) != FirstSegment);
-    i = 0;
-    Hash = 0;
-    Swaps = 0;
-    FirstActive = LastActive = 0;
-
-    /* Compute the cost of the initial tour, Cost.
-       Compute the corresponding hash value, Hash.
-       Initialize the segment list.
-       Make all nodes "active" (so that they can be used as t1). */
-    Cost = 0;
-    t1 = FirstNode;
-    do {
-        t2 = t1->OldSuc = t1->Next = t1->Suc;
-        t1->OldPred = t1->Pred;
-        t1->Rank = ++i;
-        Cost += C(t1, t2) - t1->Pi - t2->Pi;
-        Hash ^= Rand[t1->Id] * Rand[t2->Id];
-        t1->Cost = LONG_MAX;
-        for (Nt1 = t1->CandidateSet; t2 = Nt1->To; Nt1++)
-            if (t2 != t1->Pred && t2 != t1->Suc && Nt1->Cost < t1->Cost)
-                t1->Cost = Nt1->Cost;
-        t1->Parent = S;
-        S->Size++;
-        if (S->Size == 1)
-            S->First = t1;
-        S->Last = t1;
-        if (S->Size == GroupSize)
-            S = S->Suc;
-        t1->OldPredExcluded = t1->OldSucExcluded = 0;
-        t1->Next = 0;
-        Activate(t1);
-    } while ((t1 = t1->Suc) != FirstNode);
+    /* Compute the cost of the initial tour, Cost, and make the nodes
+       to be used as t1 "active" */
+    Cost = InitializeTrial();
     minimumCost = Cost;
     if (HashSearch(HTable, Hash, Cost))
         return Cost / Precision;
+    if (SwThreads > 1 && SwStrategy == BREADTH)
+        StartSwWorkers();
 
     SwapMove *initialBestSwapTree = BestSwapTree;
     //printf("\n## Start PNLS ##\n");
@@ -129,7 +85,11 @@ double LinKernighanSW() {
                 SwapTree->IsActive = 1;
                 SwapTree->G2Gain = G0;
                 coNodes = 0;
-                SwapMove *result = SwNeighborhoodBreadth(SwapTree);
+                SwapMove *result = SwStrategy == BEAM ?
+                    SwNeighborhoodBeam(SwapTree) :
+                    SwThreads > 1 ?
+                    SwNeighborhoodParallel(SwapTree) :
+                    SwNeighborhoodBreadth(SwapTree);
                 //SwNeighborhood2Opt(t1, t2, &G0, SwapTree, MaxDepth, edges);
                 if (coNodes > maxCoNodes) {
                     //printf("Nodes Generated = %d\n", coNodes);
@@ -229,6 +189,7 @@ double LinKernighanSW() {
         HashInsert(HTable, Hash, Cost);
 
     End_LinKernighan:
+    CurrentCost = Cost;
     NormalizeNodeList();
     return minimumCost / Precision;
 }
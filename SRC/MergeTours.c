@@ -0,0 +1,198 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file implement the merging of the best tours of
+   the runs (MERGE_TOURS = K).
+
+   The StoreMergeTour function is called by Solve after each run. It keeps
+   the K best distinct tours of the runs (their successor arrays).
+
+   The MergeTours function is called by Solve after the last run. The
+   candidate set of each node is replaced by the edges of the stored tours
+   that are incident to the node (the union graph). The edges are ordered
+   by the number of tours that contain them, and the Alpha field of an edge
+   is set to the number of tours that do not contain it. Edges common to
+   all stored tours are fixed, so that they cannot be removed by the
+   moves. Then FindTour is called on this reduced problem, starting from
+   the best stored tour. Since the union graph is sparse and most edges are
+   fixed, the trials are cheap, and a better combination of the tours is
+   often found.
+
+   The original candidate sets and fixed edges are restored before
+   MergeTours returns the cost of the best tour found. The tour is
+   recorded in the BetterTour array, as after a run, so that Solve may
+   record it as the best tour.
+
+   The ClearMergeTours function removes all stored tours.
+*/
+
+static long **Tours = 0;        /* The successor arrays of the tours */
+static double *Costs = 0;       /* Their costs (in increasing order) */
+static int TourCount = 0, TourSpace = 0;
+
+static int InTour(long *Suc, Node * Na, Node * Nb);
+
+void StoreMergeTour(double Cost)
+{
+    long *Suc;
+    Node *N;
+    int i, j;
+
+    if (MergeTourCount < 2)
+        return;
+    if (TourSpace < MergeTourCount) {
+        assert(Tours = (long **)
+               realloc(Tours, MergeTourCount * sizeof(long *)));
+        assert(Costs = (double *)
+               realloc(Costs, MergeTourCount * sizeof(double)));
+        for (i = TourSpace; i < MergeTourCount; i++)
+            Tours[i] = 0;
+        TourSpace = MergeTourCount;
+    }
+    if (TourCount == MergeTourCount && Cost >= Costs[TourCount - 1])
+        return;
+    /* The tour of the run is given by the BestSuc fields */
+    for (i = 0; i < TourCount && Costs[i] <= Cost; i++) {
+        if (Costs[i] < Cost)
+            continue;
+        N = FirstNode;
+        while (InTour(Tours[i], N, N->BestSuc) &&
+               (N = N->BestSuc) != FirstNode);
+        if (N == FirstNode)
+            return;             /* The tour is already stored */
+    }
+    if (TourCount < MergeTourCount)
+        TourCount++;
+    assert(Suc = (long *)
+           realloc(Tours[TourCount - 1], (Dimension + 1) * sizeof(long)));
+    for (j = TourCount - 1; j > i; j--) {
+        Tours[j] = Tours[j - 1];
+        Costs[j] = Costs[j - 1];
+    }
+    Tours[i] = Suc;
+    Costs[i] = Cost;
+    N = FirstNode;
+    do
+        Suc[N->Id] = N->BestSuc->Id;
+    while ((N = N->BestSuc) != FirstNode);
+}
+
+double MergeTours()
+{
+    Candidate **NewSet, **SavedSet, *NN, Temp;
+    Node **SavedFixedTo, **SavedInitialSuc, *N, *To;
+    long *Pred, Fixed = 0, Edges = 0, Count, k;
+    int i, j;
+    double Cost, LastTime = GetTime();
+
+    if (TourCount < 2)
+        return DBL_MAX;
+    assert(Pred = (long *)
+           malloc(TourCount * (Dimension + 1) * sizeof(long)));
+    assert(NewSet = (Candidate **)
+           malloc((Dimension + 1) * sizeof(Candidate *)));
+    assert(SavedSet = (Candidate **)
+           malloc((Dimension + 1) * sizeof(Candidate *)));
+    assert(SavedFixedTo = (Node **)
+           malloc(2 * (Dimension + 1) * sizeof(Node *)));
+    assert(SavedInitialSuc = (Node **)
+           malloc((Dimension + 1) * sizeof(Node *)));
+    for (i = 0; i < TourCount; i++)
+        for (k = 1; k <= Dimension; k++)
+            Pred[i * (Dimension + 1) + Tours[i][k]] = k;
+
+    /* Build the candidate sets of the union graph */
+    N = FirstNode;
+    do {
+        assert(NN = (Candidate *)
+               calloc(2 * TourCount + 1, sizeof(Candidate)));
+        for (i = Count = 0; i < TourCount; i++) {
+            for (j = 0; j <= 1; j++) {
+                To = &NodeSet[j == 0 ? Tours[i][N->Id] :
+                              Pred[i * (Dimension + 1) + N->Id]];
+                for (k = 0; k < Count && NN[k].To != To; k++);
+                if (k < Count)
+                    continue;
+                NN[Count].To = To;
+                NN[Count].Cost = C(N, To);
+                NN[Count].Alpha = TourCount;
+                Count++;
+            }
+        }
+        /* Order the edges by the number of tours that do not contain them */
+        for (k = 0; k < Count; k++) {
+            for (i = 0; i < TourCount; i++)
+                if (InTour(Tours[i], N, NN[k].To))
+                    NN[k].Alpha--;
+            Temp = NN[k];
+            for (j = k - 1; j >= 0 &&
+                 (Temp.Alpha < NN[j].Alpha ||
+                  (Temp.Alpha == NN[j].Alpha && Temp.Cost < NN[j].Cost));
+                 j--)
+                NN[j + 1] = NN[j];
+            NN[j + 1] = Temp;
+        }
+        Edges += Count;
+        NewSet[N->Id] = NN;
+    } while ((N = N->Suc) != FirstNode);
+
+    /* Replace the candidate sets, fix the common edges, and start from the
+       best tour */
+    N = FirstNode;
+    do {
+        SavedSet[N->Id] = N->CandidateSet;
+        SavedFixedTo[2 * N->Id] = N->FixedTo1;
+        SavedFixedTo[2 * N->Id + 1] = N->FixedTo2;
+        SavedInitialSuc[N->Id] = N->InitialSuc;
+        N->CandidateSet = NN = NewSet[N->Id];
+        N->FixedTo1 = NN[0].To && NN[0].Alpha == 0 ? NN[0].To : 0;
+        N->FixedTo2 = N->FixedTo1 && NN[1].To &&
+            NN[1].Alpha == 0 ? NN[1].To : 0;
+        Fixed += (N->FixedTo1 != 0) + (N->FixedTo2 != 0);
+        N->InitialSuc = &NodeSet[Tours[0][N->Id]];
+    } while ((N = N->Suc) != FirstNode);
+    if (TraceLevel >= 1) {
+        printf("MERGE: Tours = %d, Edges = %ld, Fixed = %ld\n",
+               TourCount, Edges / 2, Fixed / 2);
+        fflush(stdout);
+    }
+    Cost = FindTour();
+
+    /* Restore the original candidate sets and fixed edges */
+    N = FirstNode;
+    do {
+        free(N->CandidateSet);
+        N->CandidateSet = SavedSet[N->Id];
+        N->FixedTo1 = SavedFixedTo[2 * N->Id];
+        N->FixedTo2 = SavedFixedTo[2 * N->Id + 1];
+        N->InitialSuc = SavedInitialSuc[N->Id];
+    } while ((N = N->Suc) != FirstNode);
+    if (TraceLevel >= 1) {
+        printf("MERGE: Cost = %0.0f, Best tour of the runs = %0.0f, "
+               "Time = %0.3f sec.\n\n", Cost, Costs[0],
+               GetTime() - LastTime);
+        fflush(stdout);
+    }
+    free(Pred);
+    free(NewSet);
+    free(SavedSet);
+    free(SavedFixedTo);
+    free(SavedInitialSuc);
+    ClearMergeTours();
+    return Cost;
+}
+
+void ClearMergeTours()
+{
+    TourCount = 0;
+}
+
+/*
+   The InTour function returns 1 if the edge (Na,Nb) belongs to the tour
+   given by the successor array Suc; otherwise 0.
+*/
+
+static int InTour(long *Suc, Node * Na, Node * Nb)
+{
+    return Suc[Na->Id] == Nb->Id || Suc[Nb->Id] == Na->Id;
+}
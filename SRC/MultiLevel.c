@@ -0,0 +1,284 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The MultiLevel function finds the initial tour of the runs by multi-level
+   refinement (MULTI_LEVEL = L). It is called by Solve before the first run.
+
+   The problem is coarsened in at most L levels. The fixed edges form paths
+   (a node without fixed edges is a path by itself). At each level, the end
+   nodes are visited in random order, and each path that has not yet been
+   matched at the level is matched with the path of the nearest end node in
+   the candidate set of its end node, among those of other unmatched paths.
+   The edge between the two end nodes is fixed, so each level about halves
+   the number of paths. The paths are then collapsed (see CollapsePaths),
+   so that the candidate sets of the next level are those of a problem of
+   the end nodes. The coarsening stops when no edge can be fixed, or when
+   fewer than 8 end nodes remain.
+
+   A nearest neighbor tour through the paths of the coarsest level is
+   improved by FindTour. Then the levels are undone, from the coarsest to
+   the finest: the edges fixed at the level are released, the candidate
+   sets of the level are restored, and the tour of the previous level
+   (which is also a tour of this level) is improved by a single trial of
+   the Lin-Kernighan heuristic, within the time budget of a trial
+   (TRIAL_TIME_BUDGET). The tour of the finest level becomes the initial
+   tour of each run (InitialSuc), in place of the tours of
+   INITIAL_TOUR_FILE (see OverrideInitialTours).
+*/
+
+typedef struct FixedEdge {
+    Node *From, *To;
+} FixedEdge;
+
+static long *End;               /* End[a] is the other end node of the path
+                                   with end node a */
+
+static void FindEnds();
+static void PathTour();
+static void SetInitialSuc();
+static Candidate **CopySets();
+static void Unfix(Node * Na, Node * Nb);
+
+void MultiLevel()
+{
+    Candidate ***Sets, *NN, *Nearest;
+    FixedEdge *Edges;
+    Node **Order, *N, *To;
+    long *Mark, *LevelStart, Levels = 0, EdgeCount = 0, FixedCount = 0,
+        Effective = Dimension, SavedMaxTrials = MaxTrials, i, j, a, b;
+    double Cost, StartTime = GetWallTime();
+
+    if (MultiLevels <= 0)
+        return;
+    if (ProblemType != TSP) {
+        printf("MULTI_LEVEL: Ignored (the problem is not a TSP)\n");
+        return;
+    }
+    assert(Sets = (Candidate ***)
+           malloc(MultiLevels * sizeof(Candidate **)));
+    assert(Edges = (FixedEdge *) malloc(Dimension * sizeof(FixedEdge)));
+    assert(LevelStart = (long *) malloc((MultiLevels + 1) * sizeof(long)));
+    assert(Order = (Node **) malloc(Dimension * sizeof(Node *)));
+    assert(Mark = (long *) calloc(Dimension + 1, sizeof(long)));
+    assert(End = (long *) malloc((Dimension + 1) * sizeof(long)));
+    FindEnds();
+    for (i = 0; i < Dimension; i++) {
+        j = Random() % (i + 1);
+        Order[i] = Order[j];
+        Order[j] = &NodeSet[i + 1];
+    }
+
+    /* Coarsen */
+    while (Levels < MultiLevels && Effective >= 8) {
+        Sets[Levels] = CopySets();
+        LevelStart[Levels] = EdgeCount;
+        for (i = 0; i < Dimension; i++) {
+            N = Order[i];
+            if (N->FixedTo2 || Mark[N->Id] == Levels + 1)
+                continue;
+            Nearest = 0;
+            for (NN = N->CandidateSet; NN && (To = NN->To); NN++)
+                if (!To->FixedTo2 && Mark[To->Id] != Levels + 1 &&
+                    To != N && To->Id != End[N->Id] &&
+                    (!Nearest || NN->Cost < Nearest->Cost))
+                    Nearest = NN;
+            if (!Nearest)
+                continue;
+            To = Nearest->To;
+            a = End[N->Id];
+            b = End[To->Id];
+            Mark[N->Id] = Mark[a] = Mark[To->Id] = Mark[b] = Levels + 1;
+            AddCandidate(N, To, Nearest->Cost);
+            AddCandidate(To, N, Nearest->Cost);
+            if (N->FixedTo1)
+                N->FixedTo2 = To;
+            else
+                N->FixedTo1 = To;
+            if (To->FixedTo1)
+                To->FixedTo2 = N;
+            else
+                To->FixedTo1 = N;
+            End[a] = b;
+            End[b] = a;
+            Edges[EdgeCount].From = N;
+            Edges[EdgeCount++].To = To;
+        }
+        if ((FixedCount = EdgeCount - LevelStart[Levels]) == 0) {
+            for (a = 1; a <= Dimension; a++)
+                free(Sets[Levels][a]);
+            free(Sets[Levels]);
+            break;
+        }
+        Effective = CollapsePaths();
+        Levels++;
+        if (TraceLevel >= 1) {
+            printf("MULTI_LEVEL: Level %ld, Fixed = %ld, "
+                   "Effective dimension = %ld\n", Levels, FixedCount,
+                   Effective);
+            fflush(stdout);
+        }
+    }
+    LevelStart[Levels] = EdgeCount;
+
+    /* Solve the coarsest level */
+    PathTour();
+    if (MaxTrials > Effective)
+        MaxTrials = Effective;
+    Cost = FindTour();
+    if (TraceLevel >= 1) {
+        printf("MULTI_LEVEL: Level %ld, Cost = %0.0f, Time = %0.3f sec.\n",
+               Levels, Cost, GetWallTime() - StartTime);
+        fflush(stdout);
+    }
+
+    /* Uncoarsen */
+    MaxTrials = 1;
+    while (Levels > 0) {
+        SetInitialSuc();
+        for (i = LevelStart[Levels - 1]; i < LevelStart[Levels]; i++) {
+            Unfix(Edges[i].From, Edges[i].To);
+            Unfix(Edges[i].To, Edges[i].From);
+        }
+        Levels--;
+        N = FirstNode;
+        do {
+            free(N->CandidateSet);
+            N->CandidateSet = Sets[Levels][N->Id];
+        } while ((N = N->Suc) != FirstNode);
+        free(Sets[Levels]);
+        Cost = FindTour();
+        if (TraceLevel >= 1) {
+            printf("MULTI_LEVEL: Level %ld, Cost = %0.0f, "
+                   "Time = %0.3f sec.\n", Levels, Cost,
+                   GetWallTime() - StartTime);
+            fflush(stdout);
+        }
+    }
+    MaxTrials = SavedMaxTrials;
+    SetInitialSuc();
+    OverrideInitialTours();
+    if (TraceLevel >= 1)
+        printf("\n");
+    free(Sets);
+    free(Edges);
+    free(LevelStart);
+    free(Order);
+    free(Mark);
+    free(End);
+}
+
+/*
+   The FindEnds function sets End[a] for each end node a of a path of fixed
+   edges.
+*/
+
+static void FindEnds()
+{
+    Node *N, *M, *Prev, *Next;
+
+    N = FirstNode;
+    do {
+        if (N->FixedTo2)
+            continue;
+        for (Prev = 0, M = N; (Next = M->FixedTo1 != Prev ?
+                               M->FixedTo1 : M->FixedTo2); Prev = M, M = Next);
+        End[N->Id] = M->Id;
+    } while ((N = N->Suc) != FirstNode);
+}
+
+/*
+   The PathTour function sets the InitialSuc fields to a nearest neighbor
+   tour through the paths of fixed edges. From the end of a path, the tour
+   continues with the nearest end node in its candidate set that has not
+   been visited, or else with any such end node.
+*/
+
+static void PathTour()
+{
+    Node *N, *M, *Prev, *Next, *First = 0, *Last = 0;
+    Candidate *NN;
+    char *Visited;
+    long Cursor = 1, Cost = 0;
+
+    assert(Visited = (char *) calloc(Dimension + 1, sizeof(char)));
+    for (N = 0;;) {
+        if (Last)
+            for (NN = Last->CandidateSet; NN && NN->To; NN++)
+                if (!NN->To->FixedTo2 && !Visited[NN->To->Id] &&
+                    (!N || NN->Cost < Cost)) {
+                    N = NN->To;
+                    Cost = NN->Cost;
+                }
+        while (!N && Cursor <= Dimension) {
+            if (!NodeSet[Cursor].FixedTo2 && !Visited[Cursor])
+                N = &NodeSet[Cursor];
+            Cursor++;
+        }
+        if (!N)
+            break;
+        for (Prev = 0, M = N; M; Prev = M, M = Next) {
+            Visited[M->Id] = 1;
+            if (Last)
+                Last->InitialSuc = M;
+            else
+                First = M;
+            Last = M;
+            Next = M->FixedTo1 != Prev ? M->FixedTo1 : M->FixedTo2;
+        }
+        N = 0;
+    }
+    if (Last)
+        Last->InitialSuc = First;
+    free(Visited);
+}
+
+/*
+   The SetInitialSuc function sets the InitialSuc fields to the current
+   best tour (BetterTour).
+*/
+
+static void SetInitialSuc()
+{
+    long i;
+
+    for (i = 1; i <= Dimension; i++)
+        NodeSet[BetterTour[i]].InitialSuc =
+            &NodeSet[BetterTour[i % Dimension + 1]];
+}
+
+/*
+   The CopySets function returns a copy of the candidate sets of the nodes,
+   indexed by node number.
+*/
+
+static Candidate **CopySets()
+{
+    Candidate **Sets, *NN;
+    Node *N = FirstNode;
+    long Count;
+
+    assert(Sets = (Candidate **) calloc(Dimension + 1, sizeof(Candidate *)));
+    do {
+        if (!N->CandidateSet)
+            continue;
+        for (Count = 1, NN = N->CandidateSet; NN->To; NN++)
+            Count++;
+        assert(Sets[N->Id] = (Candidate *)
+               malloc(Count * sizeof(Candidate)));
+        memcpy(Sets[N->Id], N->CandidateSet, Count * sizeof(Candidate));
+    } while ((N = N->Suc) != FirstNode);
+    return Sets;
+}
+
+/*
+   The Unfix function removes Nb from the fixed neighbors of Na.
+*/
+
+static void Unfix(Node * Na, Node * Nb)
+{
+    if (Na->FixedTo1 == Nb) {
+        Na->FixedTo1 = Na->FixedTo2;
+        Na->FixedTo2 = 0;
+    } else if (Na->FixedTo2 == Nb)
+        Na->FixedTo2 = 0;
+}
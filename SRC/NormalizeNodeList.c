@@ -7,17 +7,32 @@
    two-way list. 
 
    A call of the function corrupts the segment list representation.   
+
+   If the nodes are swapped (Reversed is 1), they are marked for the
+   worker threads (see MarkChanged).
+
+   With the doubly linked list representation, Pred and Suc always
+   constitute a cyclic two-way list, and only Reversed is reset. The
+   nodes are left untouched, so that Rank still increases in the
+   successor direction, and the trial log remains valid (see
+   RestoreBestTour).
 */
 
 void NormalizeNodeList()
 {
+#ifndef SEGMENT_LIST
+    Reversed = 0;
+#else
     Node *t1, *t2;
 
     t1 = FirstNode;
     do {
         t2 = SUC(t1);
+        if (Reversed)
+            MarkChanged(t1);
         t1->Pred = PRED(t1);
         t1->Suc = t2;
     }
     while ((t1 = t2) != FirstNode);
+#endif
 }
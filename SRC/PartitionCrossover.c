@@ -0,0 +1,186 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The PartitionCrossover function recombines the tour of a finished run
+   with the incumbent, the best tour of the previous runs, by partition
+   crossover (GPX) [Whitley, Hains and Howe (2009): Tunneling between
+   optima: partition crossover for the traveling salesman problem].
+
+   The edges that are common to both tours are removed from their union
+   graph. The remaining graph splits into connected components. The common
+   edges that connect a component to the rest of the graph are used by
+   both tours, so both tours enter and leave the component at the same
+   nodes. A component is feasible if the two tours also pair these nodes
+   in the same way, that is, if each path of one tour through the
+   component has the same end nodes as a path of the other tour. (A
+   component connected by exactly two common edges is always feasible.)
+   The paths of a feasible component are then interchangeable, and the
+   cheaper set is chosen. In all other components, the edges of the better
+   parent are kept. The child is therefore never worse than the better
+   parent. Everything is done in time linear in the number of nodes.
+
+   The function is called by Solve after each run (if PARTITION_CROSSOVER
+   is YES). The tour of the run is given by the BestSuc fields, and Cost is
+   its cost. If the child is better than both parents, it becomes the
+   current tour (and is recorded by RecordBetterTour), and its cost is
+   returned. Otherwise, DBL_MAX is returned. In either case the best of the
+   three tours becomes the new incumbent.
+
+   The ClearCrossover function removes the incumbent.
+*/
+
+static long *Suc1 = 0, *Pred1, *Suc2, *Pred2;  /* The parents; Suc1 is
+                                                  the better one */
+static long *Incumbent = 0;     /* The successor array of the incumbent */
+static long *Label, *Stack, *Infeasible;   /* Indexed by node or by
+                                              component */
+static long long *Cost1 = 0, *Cost2;            /* The cost of the paths of
+                                               each parent in a component */
+static long Space = 0;
+static double IncumbentCost = DBL_MAX;
+
+static int IsCommon(long a, long b);
+
+double PartitionCrossover(double Cost)
+{
+    Node *N;
+    long Components = 0, Feasible = 0, Improved = 0, a, b, e, p, q, Prev,
+        Top, i;
+    long long Gain = 0;
+    double ChildCost;
+
+    if (!PartitionCrossoverUsed)
+        return DBL_MAX;
+    if (Space < Dimension + 1) {
+        Space = Dimension + 1;
+        assert(Suc1 = (long *) realloc(Suc1, 7 * Space * sizeof(long)));
+        Pred1 = Suc1 + Space;
+        Suc2 = Pred1 + Space;
+        Pred2 = Suc2 + Space;
+        Label = Pred2 + Space;
+        Stack = Label + Space;
+        Infeasible = Stack + Space;
+        assert(Incumbent =
+               (long *) realloc(Incumbent, Space * sizeof(long)));
+        assert(Cost1 = (long long *)
+               realloc(Cost1, 2 * Space * sizeof(long long)));
+        Cost2 = Cost1 + Space;
+    }
+    if (IncumbentCost == DBL_MAX) {
+        N = FirstNode;
+        do
+            Incumbent[N->Id] = N->BestSuc->Id;
+        while ((N = N->BestSuc) != FirstNode);
+        IncumbentCost = Cost;
+        return DBL_MAX;
+    }
+    N = FirstNode;
+    do
+        Suc2[N->Id] = N->BestSuc->Id;
+    while ((N = N->BestSuc) != FirstNode);
+    if (Cost < IncumbentCost) {
+        memcpy(Suc1, Suc2, Space * sizeof(long));
+        memcpy(Suc2, Incumbent, Space * sizeof(long));
+        IncumbentCost = Cost;
+    } else
+        memcpy(Suc1, Incumbent, Space * sizeof(long));
+    for (a = 1; a <= Dimension; a++) {
+        Pred1[Suc1[a]] = a;
+        Pred2[Suc2[a]] = a;
+        Label[a] = 0;
+    }
+
+    /* Label the components of the union graph without common edges */
+    for (a = 1; a <= Dimension; a++) {
+        if (Label[a] || (IsCommon(a, Suc1[a]) && IsCommon(a, Pred1[a])))
+            continue;
+        Label[a] = ++Components;
+        Stack[Top = 0] = a;
+        while (Top >= 0) {
+            b = Stack[Top--];
+            for (i = 0; i < 4; i++) {
+                e = i == 0 ? Suc1[b] : i == 1 ? Pred1[b] :
+                    i == 2 ? Suc2[b] : Pred2[b];
+                if (!Label[e] && !IsCommon(b, e)) {
+                    Label[e] = Components;
+                    Stack[++Top] = e;
+                }
+            }
+        }
+    }
+    /* Follow each path of the better parent through a component, from
+       where it enters (p) to where it leaves (q), and the path of the
+       other parent from p */
+    for (e = 1; e <= Components; e++) {
+        Infeasible[e] = 2;      /* Not entered (yet) */
+        Cost1[e] = Cost2[e] = 0;
+    }
+    for (a = 1; a <= Dimension; a++) {
+        if (!(e = Label[a]) || Label[Pred1[a]] == e)
+            continue;
+        if (Infeasible[e] == 2)
+            Infeasible[e] = 0;
+        for (q = a; Label[Suc1[q]] == e; q = Suc1[q])
+            Cost1[e] += C(&NodeSet[q], &NodeSet[Suc1[q]]);
+        for (p = a, Prev = Pred1[a];; Prev = p, p = b) {
+            b = Suc2[p] == Prev ? Pred2[p] : Suc2[p];
+            if (Label[b] != e)
+                break;
+            Cost2[e] += C(&NodeSet[p], &NodeSet[b]);
+        }
+        if (p != q)
+            Infeasible[e] = 1;
+    }
+
+    /* In each feasible component, choose the cheaper paths */
+    memcpy(Incumbent, Suc1, Space * sizeof(long));
+    for (e = 1; e <= Components; e++) {
+        if (Infeasible[e])
+            continue;
+        Feasible++;
+        if (Cost2[e] < Cost1[e]) {
+            Gain += Cost1[e] - Cost2[e];
+            Improved++;
+        } else
+            Infeasible[e] = 1;
+    }
+    for (a = 1; a <= Dimension; a++) {
+        if (!(e = Label[a]) || Infeasible[e] || Label[Pred1[a]] == e)
+            continue;
+        for (p = a, Prev = Pred1[a]; Label[b = Suc2[p] == Prev ?
+                                           Pred2[p] : Suc2[p]] == e;
+             Prev = p, p = b)
+            Incumbent[p] = b;
+    }
+    ChildCost = IncumbentCost - (double) Gain / Precision;
+    if (TraceLevel >= 1) {
+        printf("GPX: Components = %ld, Feasible = %ld, Improved = %ld, "
+               "Cost = %0.0f\n", Components, Feasible, Improved,
+               ChildCost);
+        fflush(stdout);
+    }
+    if (Gain == 0)
+        return DBL_MAX;
+    IncumbentCost = ChildCost;
+    FirstNode = &NodeSet[1];
+    for (a = 1; (b = Incumbent[a]) != 1; a = b)
+        Link(&NodeSet[a], &NodeSet[b]);
+    Link(&NodeSet[a], FirstNode);
+    RecordBetterTour();
+    return ChildCost;
+}
+
+void ClearCrossover()
+{
+    IncumbentCost = DBL_MAX;
+}
+
+/*
+   The IsCommon function returns 1 if the edge (a,b) of one of the parents
+   belongs to both parents; otherwise 0.
+*/
+
+static int IsCommon(long a, long b)
+{
+    return (Suc1[a] == b || Pred1[a] == b) && (Suc2[a] == b || Pred2[a] == b);
+}
@@ -0,0 +1,219 @@
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file implement the portfolio mode
+   (PORTFOLIO_FILE). In this mode, several configurations of the search
+   (engines), for example
+       MOVE_TYPE = 5
+       SW = YES ; MOVE_TYPE = 6
+       BACKTRACK_MOVE_TYPE = 3
+   solve the problem concurrently and share the best tour found so far
+   (the incumbent). The configurations are given in the format of the
+   sweep file (see Sweep).
+
+   Each configuration is run by its own worker process, since the state of
+   the solver is global. The preprocessing is done once, before the
+   workers are forked, and is inherited by them (see PreprocessingCache).
+   Worker i uses the seed SEED + i.
+
+   The incumbent is kept in shared memory. Its cost is read with a single
+   atomic load, so a worker can compare its own tour with the incumbent
+   after each trial at no cost. The tour is guarded by a sequence lock: a
+   writer makes the sequence number odd while it copies the tour, and a
+   reader retries if the number was odd or has changed during its copy.
+   Readers never block writers.
+
+   PublishIncumbent is called by FindTour with each better tour of a run.
+   If the tour is better than the incumbent, it becomes the new incumbent.
+
+   AdoptIncumbent is called by FindTour after each trial. If the best tour
+   of the current run is clearly dominated by the incumbent (its cost
+   exceeds the incumbent's by more than the fraction PORTFOLIO_MARGIN),
+   the incumbent is loaded into the node list, and its cost is returned.
+   The run then continues from the incumbent. Otherwise, Cost is returned.
+
+   When all workers have finished, the incumbent is reported and written
+   to TOUR_FILE.
+
+   DetachIncumbent is called by a child process of a worker that solves
+   another problem (see SolveSubproblems). The process no longer shares
+   the incumbent.
+*/
+
+typedef struct Incumbent {
+    long Sequence;              /* Odd while the tour is being written */
+    long long Cost;             /* The cost of the tour (LLONG_MAX = none) */
+    int Worker;                 /* The worker that found the tour */
+    int Tour[1];                /* The node list, Dimension node numbers */
+} Incumbent;
+
+typedef struct WorkerResult {
+    double Cost;                /* The best cost of the worker's runs */
+    double Time;                /* The time used by the worker */
+    int Done;                   /* Set when the worker has finished */
+} WorkerResult;
+
+static Incumbent *Shared = 0;
+static WorkerResult *Results;
+static int Worker;              /* The number of this worker */
+static int *Order = 0;          /* A private copy of the incumbent's tour */
+
+void Portfolio()
+{
+    char **Configurations, *Label;
+    long Count, i;
+    size_t Size, Offset;
+    pid_t Pid;
+    double StartTime = GetWallTime();
+    Node *N;
+
+    ResetParameters();
+    ReadProblemData();
+    Configurations = ReadConfigurations(PortfolioFileName, &Count);
+    for (i = 0; i < Count; i++) {
+        ApplyConfiguration(Configurations[i]);
+        if (MaxCandidates > SweepCandidates)
+            SweepCandidates = MaxCandidates;
+    }
+    /* Preprocess (RUNS = 0) */
+    ResetParameters();
+    Runs = 0;
+    Solve(0, 0);
+
+    /* The incumbent, followed by the results of the workers (aligned) */
+    Offset = sizeof(Incumbent) + Dimension * sizeof(int);
+    Offset = (Offset + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+    Size = Offset + Count * sizeof(WorkerResult);
+    if ((Shared = (Incumbent *) mmap(0, Size, PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_ANONYMOUS, -1,
+                                     0)) == MAP_FAILED)
+        eprintf("PORTFOLIO_FILE: Cannot allocate shared memory");
+    Shared->Sequence = 0;
+    Shared->Cost = LLONG_MAX;
+    Shared->Worker = -1;
+    Results = (WorkerResult *) ((char *) Shared + Offset);
+    assert(Order = (int *) malloc(Dimension * sizeof(int)));
+    fflush(stdout);
+
+    for (Worker = 0; Worker < Count; Worker++) {
+        if ((Pid = fork()) < 0)
+            eprintf("PORTFOLIO_FILE: Cannot create worker");
+        if (Pid > 0)
+            continue;
+        /* The worker */
+        Label = ApplyConfiguration(Configurations[Worker]);
+        printf("PORTFOLIO worker %d: %s\n", Worker, Label);
+        Seed += Worker;
+        free(TourFileName);
+        free(CheckpointFileName);
+        TourFileName = CheckpointFileName = 0;
+        Solve(0, 0);
+        Results[Worker].Cost = BestCost;
+        Results[Worker].Time = GetWallTime() - StartTime;
+        Results[Worker].Done = 1;
+        fflush(stdout);
+        exit(0);
+    }
+    while (wait(0) > 0);
+
+    /* Report the incumbent */
+    ResetParameters();
+    printf("\n");
+    for (i = 0; i < Count; i++) {
+        if (!Results[i].Done)
+            printf("PORTFOLIO worker %ld: failed\n", i);
+        else
+            printf("PORTFOLIO worker %ld: %s, Cost = %0.0f, "
+                   "Time = %0.3f sec.\n", i,
+                   ApplyConfiguration(Configurations[i]),
+                   Results[i].Cost, Results[i].Time);
+    }
+    if (Shared->Cost == LLONG_MAX)
+        eprintf("PORTFOLIO_FILE: No tour found");
+    ResetParameters();
+    for (i = 0; i < Dimension; i++) {
+        N = &NodeSet[Shared->Tour[i]];
+        if (i == 0)
+            FirstNode = N;
+        else
+            Link(&NodeSet[Shared->Tour[i - 1]], N);
+    }
+    Link(N, FirstNode);
+    RecordBetterTour();
+    RecordBestTour();
+    BestCost = (double) Shared->Cost;
+    PrintBestTour();
+    FlushBestTour();
+    printf("PORTFOLIO: Cost = %0.0f (worker %d), Time = %0.3f sec.\n",
+           BestCost, Shared->Worker, GetWallTime() - StartTime);
+    if (Optimum != -DBL_MAX)
+        printf("Gap = %0.3f%%\n", (BestCost - Optimum) / Optimum * 100.0);
+    fflush(stdout);
+    munmap(Shared, Size);
+    Shared = 0;
+}
+
+void PublishIncumbent(double Cost)
+{
+    long Sequence, i;
+    Node *N;
+
+    if (!Shared || (long long) Cost >=
+        __atomic_load_n(&Shared->Cost, __ATOMIC_ACQUIRE))
+        return;
+    /* Acquire the writer's side of the sequence lock */
+    do
+        Sequence = __atomic_load_n(&Shared->Sequence, __ATOMIC_RELAXED);
+    while ((Sequence & 1) ||
+           !__atomic_compare_exchange_n(&Shared->Sequence, &Sequence,
+                                        Sequence + 1, 0, __ATOMIC_ACQUIRE,
+                                        __ATOMIC_RELAXED));
+    if ((long long) Cost < Shared->Cost) {
+        for (i = 0, N = FirstNode; i < Dimension; i++, N = N->Suc)
+            Shared->Tour[i] = (int) N->Id;
+        Shared->Worker = Worker;
+        __atomic_store_n(&Shared->Cost, (long long) Cost, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&Shared->Sequence, Sequence + 2, __ATOMIC_RELEASE);
+}
+
+double AdoptIncumbent(double Cost)
+{
+    long long IncumbentCost;
+    long Sequence, i;
+    Node *N;
+
+    if (!Shared)
+        return Cost;
+    IncumbentCost = __atomic_load_n(&Shared->Cost, __ATOMIC_ACQUIRE);
+    if (IncumbentCost == LLONG_MAX ||
+        Cost <= IncumbentCost * (1 + PortfolioMargin))
+        return Cost;
+    /* Copy the tour (the reader's side of the sequence lock) */
+    do {
+        while ((Sequence =
+                __atomic_load_n(&Shared->Sequence,
+                                __ATOMIC_ACQUIRE)) & 1);
+        IncumbentCost = __atomic_load_n(&Shared->Cost, __ATOMIC_ACQUIRE);
+        memcpy(Order, Shared->Tour, Dimension * sizeof(int));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while (__atomic_load_n(&Shared->Sequence, __ATOMIC_RELAXED) !=
+             Sequence);
+    for (i = 0; i < Dimension; i++) {
+        N = &NodeSet[Order[i]];
+        if (i == 0)
+            FirstNode = N;
+        else
+            Link(&NodeSet[Order[i - 1]], N);
+    }
+    Link(N, FirstNode);
+    return (double) IncumbentCost;
+}
+
+void DetachIncumbent()
+{
+    Shared = 0;
+}
@@ -0,0 +1,96 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file keep the state after the preprocessing (the
+   penalties and candidate sets) in memory, in the format of the checkpoint
+   file. The state is keyed by the problem text (ProblemData) and the
+   parameters that affect the preprocessing. So a process that solves the
+   same problem several times (the server, or a parameter sweep) performs
+   the ascent only once.
+*/
+
+static char *Cache = 0;         /* The state after the last preprocessing */
+static size_t CacheSize = 0;
+static unsigned long long CacheKey = 0;
+
+static unsigned long long PreprocessingKey();
+
+/*
+   The RestorePreprocessing function restores the state after the
+   preprocessing from the cache, if the cache holds the state of the
+   current problem. It returns 1 if the state has been restored; otherwise
+   0. The parameters are as for ReadCheckpoint.
+
+   The SavePreprocessing function saves the state after the preprocessing
+   in the cache. The parameters are as for WriteCheckpoint.
+
+   The functions do nothing if the problem text is not in memory
+   (ProblemData is 0).
+*/
+
+int RestorePreprocessing(long *Run, long *TrialSum, long *MinTrial,
+                         long *Successes, double *CostSum, double *TimeSum,
+                         double *MinTime)
+{
+    unsigned Seed0 = Seed;
+    double Optimum0 = Optimum;
+    FILE *File;
+
+    if (!ProblemData || !Cache || PreprocessingKey() != CacheKey)
+        return 0;
+    if (!(File = fmemopen(Cache, CacheSize, "rb")))
+        return 0;
+    ReadState(File, "The preprocessing cache", Run, TrialSum, MinTrial,
+              Successes, CostSum, TimeSum, MinTime);
+    fclose(File);
+    /* Seed and Optimum are those of the request */
+    Seed = Seed0;
+    Optimum = Optimum0;
+    SRandom(Seed);
+    return 1;
+}
+
+void SavePreprocessing(long Run, long TrialSum, long MinTrial,
+                       long Successes, double CostSum, double TimeSum,
+                       double MinTime)
+{
+    FILE *File;
+
+    if (!ProblemData)
+        return;
+    free(Cache);
+    Cache = 0;
+    if (!(File = open_memstream(&Cache, &CacheSize)))
+        return;
+    WriteState(File, Run, TrialSum, MinTrial, Successes, CostSum, TimeSum,
+               MinTime);
+    fclose(File);
+    CacheKey = PreprocessingKey();
+}
+
+/*
+   The PreprocessingKey function returns a hash value (FNV-1a) of the
+   problem text and the parameters that affect the preprocessing.
+*/
+
+static unsigned long long PreprocessingKey()
+{
+    char Parameters[2048], *S;
+    unsigned long long Key = 14695981039346656037ULL;
+    int i;
+
+    snprintf(Parameters, sizeof(Parameters),
+             "%ld %ld %ld %ld %ld %d %.17g %d %s %s %s %s",
+             MaxCandidates, AscentCandidates, Precision, InitialPeriod,
+             InitialStepSize, Subgradient, Excess, CandidateSetSymmetric,
+             PiFileName ? PiFileName : "",
+             CandidateFileName ? CandidateFileName : "",
+             MergeTourFileName[0] ? MergeTourFileName[0] : "",
+             MergeTourFileName[1] ? MergeTourFileName[1] : "");
+    for (i = 0; i < 2; i++)
+        for (S = i == 0 ? ProblemData : Parameters; *S; S++) {
+            Key ^= (unsigned char) *S;
+            Key *= 1099511628211ULL;
+        }
+    return Key;
+}
@@ -1,27 +1,181 @@
+#include <pthread.h>
+#include <time.h>
 #include "INCLUDE/LK.h"
 
 /*
-   The PrintBestTour function prints the tour in TSPLIB format to the file 
-   specified by TourFileName. 
+   The PrintBestTour function prints the tour in TSPLIB format to the file
+   specified by TourFileName.
 
-   Nothing happens of TourFileName is 0.        
+   Nothing happens of TourFileName is 0.
+
+   If TourCallback is not 0, it is called with the cost of the tour (for
+   example, by the server, which sends each new best tour to its client).
+
+   The file is written by a background thread, so that the search is not
+   stalled by output. PrintBestTour only copies BestTour and BestCost into
+   one of two buffers (the back buffer) and wakes the writer thread. The
+   writer swaps the buffers and writes the front buffer, while the search
+   may fill the back buffer again. If several tours are printed while the
+   writer is busy, only the latest is written.
+
+   The tour is written to a temporary file, TourFileName with ".tmp"
+   appended, which is then renamed to TourFileName. Thus, a reader never
+   sees a partially written tour file.
+
+   Two consecutive writes are at least TourFileInterval seconds (wall
+   clock) apart. Improvements made in between are coalesced.
+
+   The FlushBestTour function writes the latest printed tour (if not already
+   written) and stops the writer thread. It is called when a problem has
+   been solved.
+
+   The writer thread cannot report an error by eprintf (which may return
+   control to the caller of the solver by longjmp, and must therefore be
+   called by the thread that solves the problem). If a tour cannot be
+   written, the writer instead records the error and skips the tour. The
+   first error recorded is reported by FlushBestTour.
 */
 
+typedef struct TourBuffer {
+    long *Tour;                 /* The tour */
+    double Cost;                /* The cost of the tour */
+} TourBuffer;
+
+static TourBuffer Buffer[2], *Back = &Buffer[0], *Front = &Buffer[1];
+static int Pending = 0, Stop = 0, Started = 0;
+static pthread_t Writer;
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Cond = PTHREAD_COND_INITIALIZER;
+static char WriteError[512];    /* The first error of the writer thread */
+
+static void *WriteTours(void *Arg);
+static void WriteTour(TourBuffer * B);
+static void SetWriteError(char *Format, char *FileName);
+
 void PrintBestTour()
 {
-    int i, n;
+    int i;
 
+    if (TourCallback)
+        TourCallback(BestCost);
     if (TourFileName == 0)
         return;
-    assert(TourFile = fopen(TourFileName, "w"));
-    fprintf(TourFile, "NAME : %s.tour\n", Name);
-    fprintf(TourFile, "COMMENT : Length = %0.0f\n", BestCost);
-    fprintf(TourFile, "TYPE : TOUR\n");
-    fprintf(TourFile, "DIMENSION : %d\n", Dimension);
-    fprintf(TourFile, "TOUR_SECTION  \n");
+    if (!Started) {
+        for (i = 0; i <= 1; i++)
+            assert(Buffer[i].Tour =
+                   (long *) realloc(Buffer[i].Tour,
+                                    (Dimension + 1) * sizeof(long)));
+        if (pthread_create(&Writer, 0, WriteTours, 0))
+            eprintf("PrintBestTour: Cannot create thread");
+        Started = 1;
+    }
+    pthread_mutex_lock(&Mutex);
+    memcpy(Back->Tour, BestTour, (Dimension + 1) * sizeof(long));
+    Back->Cost = BestCost;
+    Pending = 1;
+    pthread_cond_signal(&Cond);
+    pthread_mutex_unlock(&Mutex);
+}
+
+void FlushBestTour()
+{
+    char Message[sizeof(WriteError)];
+
+    if (!Started)
+        return;
+    pthread_mutex_lock(&Mutex);
+    Stop = 1;
+    pthread_cond_signal(&Cond);
+    pthread_mutex_unlock(&Mutex);
+    pthread_join(Writer, 0);
+    Started = Stop = 0;
+    if (WriteError[0]) {
+        strcpy(Message, WriteError);
+        WriteError[0] = '\0';
+        eprintf("%s", Message);
+    }
+}
+
+/*
+   The WriteTours function is executed by the writer thread.
+*/
+
+static void *WriteTours(void *Arg)
+{
+    struct timespec Next;
+    TourBuffer *B;
+
+    pthread_mutex_lock(&Mutex);
+    for (;;) {
+        while (!Pending && !Stop)
+            pthread_cond_wait(&Cond, &Mutex);
+        if (!Pending)
+            break;
+        B = Back;
+        Back = Front;
+        Front = B;
+        Pending = 0;
+        pthread_mutex_unlock(&Mutex);
+        WriteTour(Front);
+        clock_gettime(CLOCK_REALTIME, &Next);
+        Next.tv_sec += (time_t) TourFileInterval;
+        Next.tv_nsec +=
+            (long) ((TourFileInterval - (time_t) TourFileInterval) * 1e9);
+        if (Next.tv_nsec >= 1000000000) {
+            Next.tv_sec++;
+            Next.tv_nsec -= 1000000000;
+        }
+        pthread_mutex_lock(&Mutex);
+        /* Wait until the interval has elapsed, unless stopped */
+        while (!Stop &&
+               pthread_cond_timedwait(&Cond, &Mutex, &Next) == 0);
+    }
+    pthread_mutex_unlock(&Mutex);
+    return 0;
+}
+
+static void WriteTour(TourBuffer * B)
+{
+    char *TempFileName;
+    FILE *File;
+    int i, n, Failed;
+
+    if (!(TempFileName = (char *) malloc(strlen(TourFileName) + 5))) {
+        SetWriteError("PrintBestTour: Cannot write %s", TourFileName);
+        return;
+    }
+    sprintf(TempFileName, "%s.tmp", TourFileName);
+    if (!(File = fopen(TempFileName, "w"))) {
+        SetWriteError("PrintBestTour: Cannot open %s", TempFileName);
+        free(TempFileName);
+        return;
+    }
+    fprintf(File, "NAME : %s.tour\n", Name);
+    fprintf(File, "COMMENT : Length = %0.0f\n", B->Cost);
+    fprintf(File, "TYPE : TOUR\n");
+    fprintf(File, "DIMENSION : %ld\n", Dimension);
+    fprintf(File, "TOUR_SECTION  \n");
     n = ProblemType != ATSP ? Dimension : Dimension / 2;
     for (i = 1; i <= n; i++)
-        fprintf(TourFile, "%ld\n", BestTour[i]);
-    fprintf(TourFile, "-1\nEOF\n");
-    fclose(TourFile);
+        fprintf(File, "%ld\n", B->Tour[i]);
+    fprintf(File, "-1\nEOF\n");
+    Failed = ferror(File);
+    if (fclose(File) || Failed)
+        SetWriteError("PrintBestTour: Cannot write %s", TempFileName);
+    else if (rename(TempFileName, TourFileName))
+        SetWriteError("PrintBestTour: Cannot rename %s", TempFileName);
+    free(TempFileName);
+}
+
+/*
+   The SetWriteError function records an error of the writer thread, unless
+   an error has been recorded already.
+*/
+
+static void SetWriteError(char *Format, char *FileName)
+{
+    pthread_mutex_lock(&Mutex);
+    if (!WriteError[0])
+        snprintf(WriteError, sizeof(WriteError), Format, FileName);
+    pthread_mutex_unlock(&Mutex);
 }
@@ -10,16 +10,38 @@ void PrintParameters()
     printf("\nPARAMETER_FILE = %s\n",
            ParameterFileName ? ParameterFileName : "");
     printf("ASCENT_CANDIDATES = %ld\n", AscentCandidates);
+    printf("AUTO_TUNE_FILE = %s\n",
+           AutoTuneFileName ? AutoTuneFileName : "");
+    printf("AUTO_TUNE_FRACTION = %0.3f\n", AutoTuneFraction);
+    printf("AUTO_TUNE_RESULT_FILE = %s\n",
+           AutoTuneResultFileName ? AutoTuneResultFileName : "");
+    printf("BACKBONE_FIX = %0.3f\n", BackboneFraction);
+    printf("BACKBONE_RUNS = %ld\n", BackboneRuns);
     printf("BACKTRACK_MOVE_TYPE = %d\n", BacktrackMoveType);
+    printf("BATCH_FILE = %s\n", BatchFileName ? BatchFileName : "");
+    printf("BATCH_RESULT_FILE = %s\n",
+           BatchResultFileName ? BatchResultFileName : "");
+    printf("BEAM_WIDTH = %d\n", BeamWidth);
     printf("CANDIDATE_FILE = %s\n",
            CandidateFileName ? CandidateFileName : "");
+    printf("CHECKPOINT_FILE = %s\n",
+           CheckpointFileName ? CheckpointFileName : "");
+    printf("CHECKPOINT_INTERVAL = %0.3f\n", CheckpointInterval);
+    printf("DEADLINE = %0.3f\n", Deadline);
     printf("EXCESS = %0.6f\n", Excess);
+    printf("GAIN23 = %s\n",
+           Gain23Used == 2 ? "ACTIVE" : Gain23Used ? "YES" : "NO");
+    printf("GAIN23_THREADS = %d\n", Gain23Threads);
     printf("INITIAL_PERIOD = %ld\n", InitialPeriod);
     printf("INITIAL_STEP_SIZE = %ld\n", InitialStepSize);
     printf("INITIAL_TOUR_FILE = %s\n",
            InitialTourFileName ? InitialTourFileName : "");
     printf("INPUT_TOUR_FILE = %s\n",
            InputTourFileName ? InputTourFileName : "");
+    printf("KICK_TYPE = %s\n",
+           KickType == SEGMENT_DOUBLE_BRIDGE ? "SEGMENT_DOUBLE_BRIDGE" :
+           "RANDOM_RESTART");
+    printf("LK_THREADS = %d\n", LKThreads);
     printf("MAX_CANDIDATES = %ld", MaxCandidates);
     if (CandidateSetSymmetric)
         printf(" SYMMETRIC");
@@ -29,19 +51,36 @@ void PrintParameters()
     for (i = 0; i <= 1; i++)
         printf("MERGE_TOUR_FILE_%d = %s\n",
                i + 1, MergeTourFileName[i] ? MergeTourFileName[i] : "");
+    printf("MERGE_TOURS = %d\n", MergeTourCount);
     printf("MOVE_TYPE = %d\n", MoveType);
+    printf("MULTI_LEVEL = %d\n", MultiLevels);
     if (Optimum == -DBL_MAX)
         printf("OPTIMUM = -DBL_MAX\n");
     else
         printf("OPTIMUM = %0.0f\n", Optimum);
+    printf("PARTITIONING = %s %ld\n", Partitioning == KARP ? "KARP" :
+           Partitioning == KMEANS ? "KMEANS" : "NO", PartitionSize);
+    printf("PARTITION_CROSSOVER = %s\n",
+           PartitionCrossoverUsed ? "YES" : "NO");
     printf("PI_FILE = %s\n", PiFileName ? PiFileName : "");
+    printf("PORTFOLIO_FILE = %s\n",
+           PortfolioFileName ? PortfolioFileName : "");
+    printf("PORTFOLIO_MARGIN = %0.3f\n", PortfolioMargin);
     printf("PRECISION = %ld\n", Precision);
     printf("PROBLEM_FILE = %s\n", ProblemFileName ? ProblemFileName : "");
     printf("RESTRICTED_SEARCH = %s\n", RestrictedSearch ? "YES" : "NO");
     printf("RUNS = %ld\n", Runs);
     printf("SEED = %ld\n", Seed);
+    printf("SERVER = %s\n", ServerName ? ServerName : "");
+    printf("SERVER_QUEUE = %d\n", ServerQueue);
+    printf("SERVER_WORKERS = %d\n", ServerWorkers);
     printf("SUBGRADIENT = %s\n", Subgradient ? "YES" : "NO");
+    printf("SUBPROBLEM_SIZE = %ld\n", SubproblemSize);
+    printf("SWEEP_FILE = %s\n", SweepFileName ? SweepFileName : "");
+    printf("SW_STRATEGY = %s\n", SwStrategy == BEAM ? "BEAM" : "BREADTH");
+    printf("SW_THREADS = %d\n", SwThreads);
     printf("TOUR_FILE = %s\n", TourFileName ? TourFileName : "");
+    printf("TOUR_FILE_INTERVAL = %0.3f\n", TourFileInterval);
     printf("TRACE_LEVEL = %d\n", TraceLevel);
     fflush(stdout);
 }
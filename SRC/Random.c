@@ -1,78 +1,98 @@
 /*
  * This file contains a portable random generator. It will give
- * identical sequences of random integers for any platform with
- * at least 32-bit integers.
+ * identical sequences of random integers for any platform.
  *
- * A version of this generator is described in J. Bentley's column,
- * "The Software Exploratorium", Unix Review 1991. It is based on
- * Algorithm A in D. E. Knuth, The Art of Computer Programming,
- * Vol 2, Section 3.2.2, pp. 172.
+ * The generator is xoshiro256** by D. Blackman and S. Vigna,
+ * "Scrambled Linear Pseudorandom Number Generators", ACM Transactions
+ * on Mathematical Software 47(4), 2021. Its state is 256 bits, and its
+ * period is 2^256 - 1.
  *
  * The Random function returns a pseudo-random integer in the range
- * 0...INT_MAX-1.
+ * 0...INT_MAX.
  *
  * The SRandom function uses the given seed for a new sequence of
- * pseudo-random numbers.
+ * pseudo-random numbers. The state is filled from the seed by the
+ * splitmix64 generator, as recommended by the authors.
+ *
+ * The RandomJump function advances the sequence by 2^128 numbers. It is
+ * used to give threads non-overlapping subsequences of the same sequence:
+ * thread number i (i >= 1) calls SRandom with a common seed and then
+ * RandomJump i times.
+ *
+ * Each thread has its own sequence.
  */
 
+#include <stdint.h>
+
 unsigned Random(void);
 void SRandom(unsigned Seed);
+void RandomJump(void);
 
-#undef STDLIB_RANDOM
-/* #define STDLIB_RANDOM */
+static __thread uint64_t s[4];
+static __thread int initialized = 0;
 
-#ifdef STDLIB_RANDOM
-#include <stdlib.h>
-unsigned Random()
+static uint64_t rotl(const uint64_t x, int k)
 {
-    return rand();
+    return (x << k) | (x >> (64 - k));
 }
 
-void SRandom(unsigned Seed)
+static uint64_t Next()
 {
-    srand(Seed);
-}
-
-#else
-
-#include <limits.h>
-#define PRANDMAX INT_MAX
+    const uint64_t result = rotl(s[1] * 5, 7) * 9;
+    const uint64_t t = s[1] << 17;
 
-static int a = 0, b = 24, arr[55], initialized = 0;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
 
 unsigned Random()
 {
-    int t;
-
     if (!initialized)
         SRandom(7913);
-    if (a-- == 0)
-        a = 54;
-    if (b-- == 0)
-        b = 54;
-    if ((t = arr[a] - arr[b]) < 0)
-        t += PRANDMAX;
-    return (arr[a] = t);
+    return (unsigned) (Next() >> 33);
 }
 
 void SRandom(unsigned Seed)
 {
-    int i, ii, last, next;
+    uint64_t x = Seed, z;
+    int i;
 
-    Seed %= PRANDMAX;
-    arr[0] = last = Seed;
-    for (next = i = 1; i < 55; i++) {
-        ii = (21 * i) % 55;
-        arr[ii] = next;
-        if ((next = last - next) < 0)
-            next += PRANDMAX;
-        last = arr[ii];
+    for (i = 0; i < 4; i++) {
+        z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        s[i] = z ^ (z >> 31);
     }
     initialized = 1;
-    a = 0;
-    b = 24;
-    for (i = 0; i < 165; i++)
-        Random();
 }
 
-#endif
+void RandomJump()
+{
+    static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL,
+        0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    int i, b;
+
+    if (!initialized)
+        SRandom(7913);
+    for (i = 0; i < 4; i++)
+        for (b = 0; b < 64; b++) {
+            if (JUMP[i] & UINT64_C(1) << b) {
+                s0 ^= s[0];
+                s1 ^= s[1];
+                s2 ^= s[2];
+                s3 ^= s[3];
+            }
+            Next();
+        }
+    s[0] = s0;
+    s[1] = s1;
+    s[2] = s2;
+    s[3] = s3;
+}
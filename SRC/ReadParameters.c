@@ -18,6 +18,24 @@
    the ascent. The candidate set is complemented such that every candidate 
    edge is associated with both its two end nodes.
    Default: 50.
+
+   AUTO_TUNE_FILE = <string>
+   Specifies the name of a file of competing configurations of the search 
+   parameters, in the format of the SWEEP_FILE (auto-tune mode). During the
+   first part of the time given by DEADLINE, the configurations are raced
+   in short runs by successive halving, and the best one is chosen. The 
+   rest of the time is spent on solving the problem with the chosen 
+   configuration. DEADLINE must be given.
+
+   AUTO_TUNE_FRACTION = <real>
+   The fraction of DEADLINE spent on choosing the configuration in 
+   auto-tune mode.
+   Default: 0.2.
+
+   AUTO_TUNE_RESULT_FILE = <string>
+   Specifies the name of a file to which the configuration chosen in 
+   auto-tune mode is written, as parameter settings that can be copied
+   into the parameter file of later jobs.
    
    BACKTRACK_MOVE_TYPE = <integer>
    Specifies the backtrack move type to be used in local search. A backtrack 
@@ -27,6 +45,42 @@
    signifies that no backtracking is to be used.
    Default: 0. 
 
+   BACKBONE_FIX = <real>
+   Specifies the fraction of the tours of the first BACKBONE_RUNS runs that
+   an edge must belong to in order to be fixed for the remaining runs (the
+   backbone). The inner nodes of the resulting paths of fixed edges are
+   removed from the candidate sets, which reduces the effective dimension.
+   The value 0 signifies that no edges are fixed.
+   Default: 0.
+
+   BACKBONE_RUNS = <integer>
+   The number of runs whose tours determine the backbone 
+   (see BACKBONE_FIX).
+   Default: 3.
+
+   BATCH_FILE = <string>
+   Specifies the name of a manifest of problem instances to be solved one
+   after the other by the same process (batch mode). Each line of the 
+   manifest gives the name of a problem file, optionally followed by 
+   parameter settings for this instance only, each preceded by a semicolon,
+   for example,
+       instances/gr24/gr24.tsp ; RUNS = 3 ; OPTIMUM = 1272
+   Empty lines and lines starting with # are ignored. The settings of the
+   parameter file apply to all instances. PROBLEM_FILE is not required when
+   BATCH_FILE is given. One result line is written for each instance.
+
+   BATCH_RESULT_FILE = <string>
+   Specifies the name of the file to which the result lines of batch mode
+   (or sweep mode, see SWEEP_FILE) are written. The line of an instance gives the problem file, its name, its
+   dimension, the minimum, average and maximum tour cost, the minimum gap, 
+   the number of successes, the number of runs, and the time in seconds.
+   Default: standard output.
+
+   BEAM_WIDTH = <integer>
+   The number of moves kept at each level of the move tree when 
+   SW_STRATEGY = BEAM.
+   Default: 10.
+
    CANDIDATE_FILE = <string>
    Specifies the name of a file to which the candidate sets are to be written.
    If the file already exists, and the PI_FILE exists, the candidate edges are 
@@ -35,18 +89,50 @@
    of candidate edges emanating from the node, followed by the candidate edges.   
    For each candidate edge its end node number and alpha-value are given.
 
+   CHECKPOINT_FILE = <string>
+   Specifies the name of a file in which the state of the job is saved
+   between runs (the penalties, the candidate sets, the best tour, and the
+   statistics of the completed runs). If the file exists when the program
+   starts, the job is resumed from the saved state, and the ascent is not
+   repeated. The file must have been written for the same problem.
+
+   CHECKPOINT_INTERVAL = <real>
+   The minimum time in seconds (wall clock) between two checkpoints. A
+   checkpoint is always written after the ascent and after the last run.
+   The value 0 signifies that a checkpoint is written after every run.
+   Default: 0.
+
    COMMENT : <string>
    A comment.
 
    EOF
    Terminates the input data. The entry is optional.
 
+   DEADLINE = <real>
+   The maximum time in seconds (wall clock) for solving a problem. No new 
+   trial or run is started when the time is exceeded. The value 0 signifies
+   no limit.
+   Default: 0.
+
    EXCESS = <real>
    The maximum alpha-value allowed for any candidate edge is set to EXCESS 
    times the absolute value of the lower bound of a solution tour (determined 
    by the ascent).
    Default: 1.0/DIMENSION.
 
+   GAIN23 = [ YES | NO | ACTIVE ]
+   Specifies whether the Gain23 function is used to search for 
+   nonsequential moves when the stochastic walk (SW) finds no improving 
+   move. ACTIVE signifies that only starting edges incident to nodes whose 
+   tour neighbors have changed since the last unsuccessful search are tried.
+   Default: YES.
+
+   GAIN23_THREADS = <integer>
+   The number of threads used by the Gain23 function to scan the starting 
+   edges of nonsequential moves. The move made is always the one a single 
+   thread would find.
+   Default: 1.
+
    INITIAL_PERIOD = <integer>
    The length of the first period in the ascent.
    Default: DIMENSION/2 (but at least 100). 
@@ -59,6 +145,11 @@
    Specifies the name of a file containing a tour to be used as the initial tour
    in the search. The tour is given by a list of integers giving the sequence 
    in which the nodes are visited in the tour. The tour is terminated by a -1.  
+   The file may contain several tours (one TOUR_SECTION for each), or the name
+   may be that of a directory of tour files. Run number r uses tour number r
+   of the pool of tours (modulo the size of the pool). If the file contains a
+   single tour and its name contains "_input_<n>", the files with the numbers 
+   n+1, n+2, ... in place of n are also added to the pool.
 
    INPUT_TOUR_FILE = <string>
    Specifies the name of a file containing a tour. The tour is given by a 
@@ -67,6 +158,24 @@
    search (the last edge to be removed in a non-gainful move must not belong to 
    the tour). In addition, the Alpha field of its edges is set to zero.
 
+   KICK_TYPE = [ RANDOM_RESTART | SEGMENT_DOUBLE_BRIDGE ]
+   Specifies how each trial obtains its initial tour. RANDOM_RESTART
+   signifies that a new tour is constructed by ChooseInitialTour in each
+   trial. SEGMENT_DOUBLE_BRIDGE signifies that each trial (except the first)
+   starts from the currently best tour of the run, perturbed by a random
+   double-bridge move confined to a short segment of the tour. Only the end
+   nodes of the kick are made active, and a trial ends when no active nodes 
+   remain (iterated Lin-Kernighan).
+   Default: RANDOM_RESTART.
+
+   LK_THREADS = <integer>
+   The number of threads used by the Lin-Kernighan search (when SW = NO).
+   If the value is greater than 1, several active nodes are tried as t1 
+   concurrently, each on a private copy of the tour, and the improving 
+   moves found are committed one by one if they do not conflict with moves
+   committed before them.
+   Default: 1.
+
    MAX_CANDIDATES = <integer> { SYMMETRIC }
    The maximum number of candidate edges to be associated with each node.
    The integer may be followed by the keyword SYMMETRIC, signifying that 
@@ -91,17 +200,53 @@
    Specifies the name of a tour to be merged. The edges of the tour are added
    to the candidate sets with alpha-values equal to 0.               
 
+   MERGE_TOURS = <integer>
+   Specifies the number of best tours of the runs that are merged after the
+   last run. The candidate sets are restricted to the union of the edges of
+   these tours, the edges common to all of them are fixed, and a final run
+   is made on this reduced problem, starting from the best tour. The value
+   0 (or 1) signifies that no tours are merged.
+   Default: 0.
+
    MOVE_TYPE = <integer>
    Specifies the move type to be used in local search. The value can be 
    2, 3, 4 or 5 which signifies that a 2-opt, 3-opt, 4-opt or 5-opt move 
    is to be used.
    Default: 5.      
 
+   MULTI_LEVEL = <integer>
+   Specifies the maximum number of levels of multi-level refinement before
+   the first run. At each level, the paths of fixed edges (initially the
+   single nodes) are matched in pairs by their nearest candidate edges,
+   which are fixed. The coarsest problem is solved, and the levels are then
+   undone one by one, each time improving the tour by a single trial of the
+   Lin-Kernighan heuristic (within TRIAL_TIME_BUDGET). The resulting tour is
+   the initial tour of each run. The value 0 signifies that no multi-level
+   refinement is made.
+   Default: 0.
+
    OPTIMUM = <real>
    Known optimal tour length. A run will be terminated as soon as a tour 
    length less than or equal to optimum is achieved.
    Default: -DBL_MAX.
 
+   PARTITIONING = [ KARP | KMEANS | NO ] [ <integer> ]
+   Specifies that the nodes are split into cells of at most the given
+   number of nodes (default 1000), instead of making an ascent on the whole
+   problem. KARP splits the nodes recursively at the median of the longer
+   side of their bounding box. KMEANS clusters them by k-means. Each cell
+   is solved in parallel, which gives the penalties and candidate sets of
+   its nodes, and the tours of the cells are stitched into the initial tour
+   of the runs. Only for problems given by coordinates.
+   Default: NO.
+
+   PARTITION_CROSSOVER = [ YES | NO ]
+   Specifies whether the tour of each run is recombined with the best tour
+   of the previous runs by partition crossover (GPX). Components of the
+   union graph of the two tours that are separated from the rest by two
+   common edges take the cheaper of the two paths through them.
+   Default: NO.
+
    PI_FILE = <string>
    Specifies the name of a file to which penalties (pi-values determined 
    by the ascent) are to be written. If the file already exists, the penalties 
@@ -111,6 +256,22 @@
    where the first integer is a node number, and the second integer is the
    Pi-value associated with the node.
 
+   PORTFOLIO_FILE = <string>
+   Specifies the name of a file of configurations of the search (engines),
+   in the format of the SWEEP_FILE (portfolio mode). Each configuration is
+   run concurrently by its own worker process, for example, 
+       MOVE_TYPE = 5
+       SW = YES ; MOVE_TYPE = 6
+       BACKTRACK_MOVE_TYPE = 3
+   The workers share the best tour found so far (the incumbent), which is
+   written to TOUR_FILE when all workers have finished.
+
+   PORTFOLIO_MARGIN = <real>
+   A worker in portfolio mode continues from the incumbent if the cost of
+   its own best tour of the run exceeds the cost of the incumbent by more 
+   than this fraction.
+   Default: 0.01.
+
    PRECISION = <integer>
    The internal precision in the representation of transformed distances: 
        d[i][j] = PRECISION*c[i][j] + pi[i] + pi[j], 
@@ -132,13 +293,74 @@
    Specifies the initial seed for random number generation.
    Default: 1.
 
+   SERVER = <string>
+   Specifies that the program is to run as a server (daemon) that solves
+   problems on request. The value is the name of a Unix domain socket on 
+   which requests are accepted, or - for requests on standard input (and
+   responses on standard output). See the Serve function for the protocol.
+   PROBLEM_FILE is not required when SERVER is given.
+
+   SERVER_QUEUE = <integer>
+   The maximum number of requests waiting to be served (the length of the
+   socket's queue of pending connections).
+   Default: 16.
+
+   SERVER_WORKERS = <integer>
+   The number of worker processes of the server. Each worker serves one
+   request at a time and keeps its own preprocessing cache.
+   Default: 1.
+
    SUBGRADIENT: [ YES | NO ]
    Specifies whether the pi-values should be determined by subgradient 
    optimization.
    Default: YES.
 
+   SUBPROBLEM_SIZE = <integer>
+   Specifies the number of nodes of the subproblems into which the best tour
+   is decomposed after the last run. The tour is cut into segments of about
+   this many nodes, and each segment is solved as a problem of its own, with
+   its end nodes fixed. The subproblems are solved in parallel, and the
+   improved segments replace those of the tour. This is repeated, with
+   shifted segments, as long as the tour improves. The value 0 signifies
+   that no subproblems are solved.
+   Default: 0.
+
+   SWEEP_FILE = <string>
+   Specifies the name of a file of configurations of the search parameters
+   (sweep mode). The problem is solved once for each configuration, and one
+   result line, preceded by the configuration, is written for each. Each
+   line of the file gives settings separated by semicolons. A setting may
+   list several values separated by commas, which stands for all 
+   combinations of the values, for example,
+       LAMBDA = 2, 3 ; MAX_CANDIDATES = 5, 8 ; SAMPLING_BIAS = BIASED
+   The preprocessing is done only once, with the largest MAX_CANDIDATES of 
+   all configurations.
+
+   SW_STRATEGY = [ BREADTH | BEAM ]
+   Specifies how the move tree of the stochastic walk (SW) is explored. 
+   BREADTH signifies a breadth-first search of the full tree of sampled 
+   moves. BEAM signifies a beam search that expands only the BEAM_WIDTH 
+   moves with the largest partial gains at each level. The space used by 
+   BEAM grows linearly with MAX_DEPTH, instead of exponentially.
+   SW_THREADS is ignored when BEAM is used.
+   Default: BREADTH.
+
+   SW_THREADS = <integer>
+   The number of threads used by the stochastic walk (when SW = YES).
+   If the value is greater than 1, the branches of each move tree are 
+   explored concurrently, each on a private copy of the tour, and the 
+   search stops as soon as one of them has found an improving move.
+   Default: 1.
+
    TOUR_FILE = <string>
    Specifies the name of a file to which the best tour is to be written.
+   The file is written by a background thread and replaced atomically.
+
+   TOUR_FILE_INTERVAL = <real>
+   The minimum time in seconds (wall clock) between two writes of the 
+   TOUR_FILE. Improvements found in between are coalesced. The last tour 
+   is always written before the program terminates.
+   Default: 1.0.
 
    TRACE_LEVEL = <integer>
    Specifies the level of detail of the output given during the solution 
@@ -149,21 +371,53 @@
 
 static char Delimiters[] = " =\n\t\r\f\v";
 
-static char *GetFileName(char *Line);
+static char **Lines = 0;        /* The lines of the parameter file */
+static long LineCount = 0, LineSpace = 0;
+static char *Scratch = 0;       /* A copy of a line to be processed */
+static size_t ScratchSpace = 0;
+static FILE *BatchFile = 0;
 
-void ReadParameters() {
-    char *Line, *Keyword, *Token;
-    int i;
+static char *GetFileName(char *Line);
 
+static void SetDefaults() {
+    free(ProblemFileName);
+    free(PiFileName);
+    free(InputTourFileName);
+    free(TourFileName);
+    free(CandidateFileName);
+    free(InitialTourFileName);
+    free(CheckpointFileName);
+    free(MergeTourFileName[0]);
+    free(MergeTourFileName[1]);
     ProblemFileName = PiFileName = InputTourFileName = TourFileName = 0;
-    CandidateFileName = InitialTourFileName = 0;
+    CandidateFileName = InitialTourFileName = CheckpointFileName = 0;
     MergeTourFileName[0] = MergeTourFileName[1] = 0;
     Runs = 10;
     Seed = 1;
     MaxTrials = 0;
+    MergeTourCount = 0;
+    BackboneFraction = 0;
+    BackboneRuns = 3;
+    PartitionCrossoverUsed = 0;
+    Partitioning = NO_PARTITIONING;
+    PartitionSize = 1000;
+    SubproblemSize = 0;
+    MultiLevels = 0;
     MaxSwaps = -1;
     MaxCandidates = 5;
     Gain23Used = 1;
+    Gain23Threads = 1;
+    LKThreads = 1;
+    SwThreads = 1;
+    TourFileInterval = 1.0;
+    CheckpointInterval = 0;
+    Deadline = 0;
+    AutoTuneFraction = 0.2;
+    PortfolioMargin = 0.01;
+    SwStrategy = BREADTH;
+    BeamWidth = 10;
+    ServerQueue = 16;
+    ServerWorkers = 1;
     GainCriterionUsed = 1;
     SW = 0;
     AscentCandidates = 50;
@@ -174,255 +428,538 @@ void ReadParameters() {
     Excess = 0.0;
     TraceLevel = 1;
     MoveType = 5;
+    KickType = RANDOM_RESTART;
     BacktrackMoveType = 0;
     RestrictedSearch = 1;
     IntensificationDiversificationBest = 0;
     IntensificationDiversificationAny = 0;
+    Lambda = 0;
+    MaxDepth = 0;
+    TrialTimeBudget = 0;
+    SamplingBiasUsed = 0;
+    PrintGapTime = 0;
+    SwNeighborhoodLimitTimeExceed = 0;
+    CandidateSetSymmetric = 0;
+}
 
+void ReadParameters() {
+    char *Line;
 
+    SetDefaults();
     if (!(ParameterFile = fopen(ParameterFileName, "r")))
         eprintf("Cannot open %s", ParameterFileName);
-    while (Line = ReadLine(ParameterFile)) {
-        if (!(Keyword = strtok(Line, Delimiters)))
-            continue;
-        for (i = 0; i < strlen(Keyword); i++)
-            Keyword[i] = (char) toupper(Keyword[i]);
-        if (!strcmp(Keyword, "ASCENT_CANDIDATES")) {
-            if (sscanf(strtok(0, Delimiters), "%ld", &AscentCandidates)) {
-                if (AscentCandidates <= 0)
-                    eprintf
-                            ("(ASCENT_CANDIDATES): positive integer expected");
-            }
-        } else if (!strcmp(Keyword, "BACKTRACK_MOVE_TYPE")) {
-            if (!sscanf(strtok(0, Delimiters), "%d", &BacktrackMoveType))
-                eprintf("(BACKTRACK_MOVE_TYPE): integer expected");
-            if (BacktrackMoveType < 0 ||
-                BacktrackMoveType == 1 || BacktrackMoveType > 5)
-                eprintf("(BACKTRACK_MOVE_TYPE): 0, 2, 3, 4 or 5 expected");
-        } else if (!strcmp(Keyword, "CANDIDATE_FILE")) {
-            if (!(CandidateFileName = GetFileName(0)))
-                eprintf("(CANDIDATE_FILE): string expected");
-        } else if (!strcmp(Keyword, "COMMENT"));
-        else if (!strcmp(Keyword, "EOF"))
+    while ((Line = ReadLine(ParameterFile))) {
+        if (LineCount == LineSpace)
+            assert(Lines = (char **)
+                   realloc(Lines, (LineSpace = 2 * LineSpace + 16) *
+                           sizeof(char *)));
+        assert(Lines[LineCount] = (char *) malloc(strlen(Line) + 1));
+        strcpy(Lines[LineCount++], Line);
+        if (!ReadParameter(Line))
             break;
-        else if (!strcmp(Keyword, "SW")) {
-            if (Token = strtok(0, Delimiters)) {
-                for (i = 0; i < strlen(Token); i++)
-                    Token[i] = (char) toupper(Token[i]);
-                if (!strcmp(Token, "YES"))
-                    SW = 1;
-                else if (!strcmp(Token, "NO"))
-                    SW = 0;
-                else
-                    Token = 0;
-            }
-            if (!Token)
-                eprintf("(SW): YES or NO expected");
-        } else if (!strcmp(Keyword, "SAMPLING_BIAS")) {
-            if (Token = strtok(0, Delimiters)) {
-                for (i = 0; i < strlen(Token); i++)
-                    Token[i] = (char) toupper(Token[i]);
-                if (!strcmp(Token, "BIASED"))
-                    SamplingBiasUsed = 2;
-                else if (!strcmp(Token, "RANDOM"))
-                    SamplingBiasUsed = 1;
-                else if (!strcmp(Token, "LKH"))
-                    SamplingBiasUsed = 0;
-            }
-            if (!Token)
-                eprintf("(SAMPLING_BIAS): YES or NO expected");
-        } else if (!strcmp(Keyword, "GAIN23")) {
-            if (Token = strtok(0, Delimiters)) {
-                for (i = 0; i < strlen(Token); i++)
-                    Token[i] = (char) toupper(Token[i]);
-                if (!strcmp(Token, "YES"))
-                    Gain23Used = 1;
-                else if (!strcmp(Token, "NO"))
-                    Gain23Used = 0;
-                else
-                    Token = 0;
-            }
-            if (!Token)
-                eprintf("(GAIN_23): YES or NO expected");
-        } else if (!strcmp(Keyword, "GAIN_CRITERION")) {
+    }
+    if (!ProblemFileName && !BatchFileName && !ServerName)
+        eprintf("Problem file name is missing.");
+    if ((BatchFileName != 0) + (SweepFileName != 0) +
+        (AutoTuneFileName != 0) + (PortfolioFileName != 0) > 1)
+        eprintf("Only one of BATCH_FILE, SWEEP_FILE, AUTO_TUNE_FILE and "
+                "PORTFOLIO_FILE may be given");
+    fclose(ParameterFile);
+}
+
+/*
+   The ResetParameters function sets the parameters to their values after
+   ReadParameters, that is, the defaults overridden by the parameter file.
+   The parameter file is not read again. Its lines were kept by
+   ReadParameters.
+*/
+
+void ResetParameters() {
+    long i;
+
+    SetDefaults();
+    for (i = 0; i < LineCount; i++) {
+        if (strlen(Lines[i]) >= ScratchSpace)
+            assert(Scratch = (char *)
+                   realloc(Scratch, ScratchSpace =
+                           2 * strlen(Lines[i]) + 1));
+        strcpy(Scratch, Lines[i]);
+        if (!ReadParameter(Scratch))
+            break;
+    }
+}
+
+/*
+   The ReadBatchInstance function reads the next instance from the manifest
+   given by BATCH_FILE and sets the parameters for solving it. It returns 0
+   if there are no more instances.
+
+   The parameters of an instance are the defaults, overridden by the
+   parameter file (see ResetParameters), overridden by the settings on the
+   instance's line.
+*/
+
+int ReadBatchInstance() {
+    char *Line, *Field, *Next;
+
+    if (!BatchFile && !(BatchFile = fopen(BatchFileName, "r")))
+        eprintf("Cannot open BATCH_FILE: %s", BatchFileName);
+    while ((Line = ReadLine(BatchFile))) {
+        Line += strspn(Line, " \t");
+        if (*Line == '\0' || *Line == '#')
+            continue;
+        ResetParameters();
+        if ((Next = strchr(Line, ';')))
+            *Next++ = '\0';
+        free(ProblemFileName);
+        if (!(ProblemFileName = GetFileName(Line)))
+            eprintf("BATCH_FILE: Problem file name expected");
+        while ((Field = Next)) {
+            if ((Next = strchr(Field, ';')))
+                *Next++ = '\0';
+            ReadParameter(Field);
+        }
+        return 1;
+    }
+    fclose(BatchFile);
+    BatchFile = 0;
+    return 0;
+}
+/*
+   The ReadParameter function processes one line of parameter input. It
+   returns 0 if the line contains the EOF keyword; otherwise 1.
+*/
+
+int ReadParameter(char *Line) {
+    char *Keyword, *Token;
+    int i;
+
+    if (!(Keyword = strtok(Line, Delimiters)))
+        return 1;
+    for (i = 0; i < strlen(Keyword); i++)
+        Keyword[i] = (char) toupper(Keyword[i]);
+    if (!strcmp(Keyword, "ASCENT_CANDIDATES")) {
+        if (sscanf(strtok(0, Delimiters), "%ld", &AscentCandidates)) {
+            if (AscentCandidates <= 0)
+                eprintf
+                        ("(ASCENT_CANDIDATES): positive integer expected");
+        }
+    } else if (!strcmp(Keyword, "AUTO_TUNE_FILE")) {
+        free(AutoTuneFileName);
+        if (!(AutoTuneFileName = GetFileName(0)))
+            eprintf("(AUTO_TUNE_FILE): string expected");
+    } else if (!strcmp(Keyword, "AUTO_TUNE_FRACTION")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%lf", &AutoTuneFraction))
+            eprintf("(AUTO_TUNE_FRACTION): real expected");
+        if (AutoTuneFraction <= 0 || AutoTuneFraction >= 1)
+            eprintf("(AUTO_TUNE_FRACTION): real in (0, 1) expected");
+    } else if (!strcmp(Keyword, "AUTO_TUNE_RESULT_FILE")) {
+        free(AutoTuneResultFileName);
+        if (!(AutoTuneResultFileName = GetFileName(0)))
+            eprintf("(AUTO_TUNE_RESULT_FILE): string expected");
+    } else if (!strcmp(Keyword, "BACKTRACK_MOVE_TYPE")) {
+        if (!sscanf(strtok(0, Delimiters), "%d", &BacktrackMoveType))
+            eprintf("(BACKTRACK_MOVE_TYPE): integer expected");
+        if (BacktrackMoveType < 0 ||
+            BacktrackMoveType == 1 || BacktrackMoveType > 5)
+            eprintf("(BACKTRACK_MOVE_TYPE): 0, 2, 3, 4 or 5 expected");
+    } else if (!strcmp(Keyword, "BACKBONE_FIX")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%lf", &BackboneFraction))
+            eprintf("(BACKBONE_FIX): real expected");
+        if (BackboneFraction < 0 || BackboneFraction > 1)
+            eprintf("(BACKBONE_FIX): real in [0;1] expected");
+    } else if (!strcmp(Keyword, "BACKBONE_RUNS")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%ld", &BackboneRuns))
+            eprintf("(BACKBONE_RUNS): integer expected");
+        if (BackboneRuns < 1)
+            eprintf("(BACKBONE_RUNS): positive integer expected");
+    } else if (!strcmp(Keyword, "BATCH_FILE")) {
+        free(BatchFileName);
+        if (!(BatchFileName = GetFileName(0)))
+            eprintf("(BATCH_FILE): string expected");
+    } else if (!strcmp(Keyword, "BATCH_RESULT_FILE")) {
+        free(BatchResultFileName);
+        if (!(BatchResultFileName = GetFileName(0)))
+            eprintf("(BATCH_RESULT_FILE): string expected");
+    } else if (!strcmp(Keyword, "CANDIDATE_FILE")) {
+        if (!(CandidateFileName = GetFileName(0)))
+            eprintf("(CANDIDATE_FILE): string expected");
+    } else if (!strcmp(Keyword, "CHECKPOINT_FILE")) {
+        if (!(CheckpointFileName = GetFileName(0)))
+            eprintf("(CHECKPOINT_FILE): string expected");
+    } else if (!strcmp(Keyword, "CHECKPOINT_INTERVAL")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%lf", &CheckpointInterval))
+            eprintf("CHECKPOINT_INTERVAL: real expected");
+        if (CheckpointInterval < 0)
+            eprintf("CHECKPOINT_INTERVAL: non-negative real expected");
+    } else if (!strcmp(Keyword, "COMMENT"));
+    else if (!strcmp(Keyword, "EOF"))
+        return 0;
+    else if (!strcmp(Keyword, "SW")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "YES"))
+                SW = 1;
+            else if (!strcmp(Token, "NO"))
+                SW = 0;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(SW): YES or NO expected");
+    } else if (!strcmp(Keyword, "SAMPLING_BIAS")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "BIASED"))
+                SamplingBiasUsed = 2;
+            else if (!strcmp(Token, "RANDOM"))
+                SamplingBiasUsed = 1;
+            else if (!strcmp(Token, "LKH"))
+                SamplingBiasUsed = 0;
+        }
+        if (!Token)
+            eprintf("(SAMPLING_BIAS): YES or NO expected");
+    } else if (!strcmp(Keyword, "GAIN23")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "YES"))
+                Gain23Used = 1;
+            else if (!strcmp(Token, "NO"))
+                Gain23Used = 0;
+            else if (!strcmp(Token, "ACTIVE"))
+                Gain23Used = 2;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(GAIN_23): YES, NO or ACTIVE expected");
+    } else if (!strcmp(Keyword, "GAIN23_THREADS")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &Gain23Threads))
+            eprintf("GAIN23_THREADS: integer expected");
+        if (Gain23Threads < 1)
+            eprintf("GAIN23_THREADS: positive integer expected");
+    } else if (!strcmp(Keyword, "GAIN_CRITERION")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "YES"))
+                GainCriterionUsed = 1;
+            else if (!strcmp(Token, "NO"))
+                GainCriterionUsed = 0;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(GAIN_CRITERION): YES or NO expected");
+    } else if (!strcmp(Keyword, "TRIAL_TIME_BUDGET")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &TrialTimeBudget))
+            eprintf("TRIAL_TIME_BUDGET: integer expected");
+        if (TrialTimeBudget <= 0)
+            eprintf("TRIAL_TIME_BUDGET: strictly non-negative integer expected");
+    } else if (!strcmp(Keyword, "PRINT_GAP_TIME")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%lf", &PrintGapTime))
+            eprintf("PRINT_GAP_TIME: integer expected");
+        if (PrintGapTime <= 0)
+            eprintf("PRINT_GAP_TIME: strictly non-negative integer expected");
+    } else if (!strcmp(Keyword, "SW_NEIGHBORHOOD_TIME_EXCEED")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%lf", &SwNeighborhoodLimitTimeExceed))
+            eprintf("SW_NEIGHBORHOOD_TIME_EXCEED: double expected");
+        if (TrialTimeBudget <= 0)
+            eprintf("SW_NEIGHBORHOOD_TIME_EXCEED: strictly non-negative double expected");
+    } else if (!strcmp(Keyword, "SW_STRATEGY")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "BREADTH"))
+                SwStrategy = BREADTH;
+            else if (!strcmp(Token, "BEAM"))
+                SwStrategy = BEAM;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(SW_STRATEGY): BREADTH or BEAM expected");
+    } else if (!strcmp(Keyword, "BEAM_WIDTH")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &BeamWidth))
+            eprintf("BEAM_WIDTH: integer expected");
+        if (BeamWidth < 1)
+            eprintf("BEAM_WIDTH: positive integer expected");
+    } else if (!strcmp(Keyword, "SW_THREADS")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &SwThreads))
+            eprintf("SW_THREADS: integer expected");
+        if (SwThreads < 1)
+            eprintf("SW_THREADS: positive integer expected");
+    } else if (!strcmp(Keyword, "ID")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "BEST"))
+                IntensificationDiversificationBest = 1;
+            else if (!strcmp(Token, "ANY"))
+                IntensificationDiversificationAny = 1;
+        }
+        if (!Token)
+            eprintf("(SW): BEST or ANY expected");
+    } else if (!strcmp(Keyword, "MAX_DEPTH")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &MaxDepth))
+            eprintf("MAX_DEPTH: integer expected");
+        if (MaxDepth < 0)
+            eprintf("MAX_DEPTH: non-negative integer expected");
+    } else if (!strcmp(Keyword, "LAMBDA")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &Lambda))
+            eprintf("LAMBDA_CANDIDATES : integer expected");
+        if (Lambda < 0)
+            eprintf("LAMBDA_CANDIDATES : strictly non-negative integer expected");
+    } else if (!strcmp(Keyword, "DEADLINE")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%lf", &Deadline))
+            eprintf("DEADLINE: real expected");
+        if (Deadline < 0)
+            eprintf("DEADLINE: non-negative real expected");
+    } else if (!strcmp(Keyword, "EXCESS")) {
+        if (!sscanf(strtok(0, Delimiters), "%lf", &Excess))
+            eprintf("(EXCESS): real expected");
+    } else if (!strcmp(Keyword, "INITIAL_PERIOD")) {
+        if (sscanf(strtok(0, Delimiters), "%ld", &InitialPeriod)) {
+            if (InitialPeriod <= 0)
+                eprintf("(INITIAL_PERIOD): positive integer expected");
+        } else
+            eprintf("(INITIAL_PERIOD): integer expected");
+    } else if (!strcmp(Keyword, "INITIAL_STEP_SIZE")) {
+        if (sscanf(strtok(0, Delimiters), "%ld", &InitialStepSize)) {
+            if (InitialStepSize <= 0)
+                eprintf
+                        ("(INITIAL_STEP_SIZE): positive integer expected");
+        } else
+            eprintf("(INITIAL_STEP_SIZE): integer expected");
+    } else if (!strcmp(Keyword, "INITIAL_TOUR_FILE")) {
+        if (!(InitialTourFileName = GetFileName(0)))
+            eprintf("(INITIAL_TOUR_FILE): string expected");
+    } else if (!strcmp(Keyword, "INPUT_TOUR_FILE")) {
+        if (!(InputTourFileName = GetFileName(0)))
+            eprintf("(INPUT_TOUR_FILE): string expected");
+    } else if (!strcmp(Keyword, "KICK_TYPE")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "RANDOM_RESTART"))
+                KickType = RANDOM_RESTART;
+            else if (!strcmp(Token, "SEGMENT_DOUBLE_BRIDGE"))
+                KickType = SEGMENT_DOUBLE_BRIDGE;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(KICK_TYPE): RANDOM_RESTART or "
+                    "SEGMENT_DOUBLE_BRIDGE expected");
+    } else if (!strcmp(Keyword, "LK_THREADS")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &LKThreads))
+            eprintf("LK_THREADS: integer expected");
+        if (LKThreads < 1)
+            eprintf("LK_THREADS: positive integer expected");
+    } else if (!(strcmp(Keyword, "MAX_CANDIDATES"))) {
+        if (sscanf(strtok(0, Delimiters), "%ld", &MaxCandidates)) {
+            if (MaxCandidates < 0)
+                eprintf
+                        ("(MAX_CANDIDATES): non-negative integer expected");
             if (Token = strtok(0, Delimiters)) {
                 for (i = 0; i < strlen(Token); i++)
                     Token[i] = (char) toupper(Token[i]);
-                if (!strcmp(Token, "YES"))
-                    GainCriterionUsed = 1;
-                else if (!strcmp(Token, "NO"))
-                    GainCriterionUsed = 0;
+                if (!strcmp(Token, "SYMMETRIC"))
+                    CandidateSetSymmetric = 1;
                 else
-                    Token = 0;
-            }
-            if (!Token)
-                eprintf("(GAIN_CRITERION): YES or NO expected");
-        } else if (!strcmp(Keyword, "TRIAL_TIME_BUDGET")) {
-            if (!(Token = strtok(0, Delimiters)) ||
-                !sscanf(Token, "%d", &TrialTimeBudget))
-                eprintf("TRIAL_TIME_BUDGET: integer expected");
-            if (TrialTimeBudget <= 0)
-                eprintf("TRIAL_TIME_BUDGET: strictly non-negative integer expected");
-        } else if (!strcmp(Keyword, "PRINT_GAP_TIME")) {
-            if (!(Token = strtok(0, Delimiters)) ||
-                !sscanf(Token, "%lf", &PrintGapTime))
-                eprintf("PRINT_GAP_TIME: integer expected");
-            if (PrintGapTime <= 0)
-                eprintf("PRINT_GAP_TIME: strictly non-negative integer expected");
-        } else if (!strcmp(Keyword, "SW_NEIGHBORHOOD_TIME_EXCEED")) {
-            if (!(Token = strtok(0, Delimiters)) ||
-                !sscanf(Token, "%lf", &SwNeighborhoodLimitTimeExceed))
-                eprintf("SW_NEIGHBORHOOD_TIME_EXCEED: double expected");
-            if (TrialTimeBudget <= 0)
-                eprintf("SW_NEIGHBORHOOD_TIME_EXCEED: strictly non-negative double expected");
-        } else if (!strcmp(Keyword, "ID")) {
-            if (Token = strtok(0, Delimiters)) {
-                for (i = 0; i < strlen(Token); i++)
-                    Token[i] = (char) toupper(Token[i]);
-                if (!strcmp(Token, "BEST"))
-                    IntensificationDiversificationBest = 1;
-                else if (!strcmp(Token, "ANY"))
-                    IntensificationDiversificationAny = 1;
-            }
-            if (!Token)
-                eprintf("(SW): BEST or ANY expected");
-        } else if (!strcmp(Keyword, "MAX_DEPTH")) {
-            if (!(Token = strtok(0, Delimiters)) ||
-                !sscanf(Token, "%d", &MaxDepth))
-                eprintf("MAX_DEPTH: integer expected");
-            if (MaxDepth < 0)
-                eprintf("MAX_DEPTH: non-negative integer expected");
-        } else if (!strcmp(Keyword, "LAMBDA")) {
-            if (!(Token = strtok(0, Delimiters)) ||
-                !sscanf(Token, "%d", &Lambda))
-                eprintf("LAMBDA_CANDIDATES : integer expected");
-            if (Lambda < 0)
-                eprintf("LAMBDA_CANDIDATES : strictly non-negative integer expected");
-        } else if (!strcmp(Keyword, "EXCESS")) {
-            if (!sscanf(strtok(0, Delimiters), "%lf", &Excess))
-                eprintf("(EXCESS): real expected");
-        } else if (!strcmp(Keyword, "INITIAL_PERIOD")) {
-            if (sscanf(strtok(0, Delimiters), "%ld", &InitialPeriod)) {
-                if (InitialPeriod <= 0)
-                    eprintf("(INITIAL_PERIOD): positive integer expected");
-            } else
-                eprintf("(INITIAL_PERIOD): integer expected");
-        } else if (!strcmp(Keyword, "INITIAL_STEP_SIZE")) {
-            if (sscanf(strtok(0, Delimiters), "%ld", &InitialStepSize)) {
-                if (InitialStepSize <= 0)
                     eprintf
-                            ("(INITIAL_STEP_SIZE): positive integer expected");
-            } else
-                eprintf("(INITIAL_STEP_SIZE): integer expected");
-        } else if (!strcmp(Keyword, "INITIAL_TOUR_FILE")) {
-            if (!(InitialTourFileName = GetFileName(0)))
-                eprintf("(INITIAL_TOUR_FILE): string expected");
-        } else if (!strcmp(Keyword, "INPUT_TOUR_FILE")) {
-            if (!(InputTourFileName = GetFileName(0)))
-                eprintf("(INPUT_TOUR_FILE): string expected");
-        } else if (!(strcmp(Keyword, "MAX_CANDIDATES"))) {
-            if (sscanf(strtok(0, Delimiters), "%ld", &MaxCandidates)) {
-                if (MaxCandidates < 0)
-                    eprintf
-                            ("(MAX_CANDIDATES): non-negative integer expected");
-                if (Token = strtok(0, Delimiters)) {
-                    for (i = 0; i < strlen(Token); i++)
-                        Token[i] = (char) toupper(Token[i]);
-                    if (!strcmp(Token, "SYMMETRIC"))
-                        CandidateSetSymmetric = 1;
-                    else
-                        eprintf
-                                ("(MAXCANDIDATES) illegal symmetry specification");
-                }
+                            ("(MAXCANDIDATES) illegal symmetry specification");
             }
-        } else if (!strcmp(Keyword, "MAX_SWAPS")) {
-            if (sscanf(strtok(0, Delimiters), "%ld", &MaxSwaps)) {
-                if (MaxSwaps < 0)
-                    eprintf("(MAX_SWAPS): non-negative integer expected");
-            } else
-                eprintf("(MAX_TRIALS): integer expected");
-        } else if (!strcmp(Keyword, "MAX_TRIALS")) {
-            if (sscanf(strtok(0, Delimiters), "%ld", &MaxTrials)) {
-                if (MaxTrials <= 0)
-                    eprintf("(MAX_TRIALS): positive integer expected");
-            } else
-                eprintf("(MAX_TRIALS): integer expected");
-        } else if (!strcmp(Keyword, "MERGE_TOUR_FILE_1")) {
-            if (!(MergeTourFileName[0] = GetFileName(0)))
-                eprintf("(MERGE_TOUR_FILE_1): string expected");
-        } else if (!strcmp(Keyword, "MERGE_TOUR_FILE_2")) {
-            if (!(MergeTourFileName[1] = GetFileName(0)))
-                eprintf("(MERGE_TOUR_FILE_2): string expected");
-        } else if (!strcmp(Keyword, "MOVE_TYPE")) {
-            if (!sscanf(strtok(0, Delimiters), "%d", &MoveType))
-                eprintf("(MOVE_TYPE): integer expected");
-            if (MoveType < 2 || MoveType > 7)
-                eprintf("(MOVE_TYPE): 2, 3, 4 or 5 expected");
-        } else if (!strcmp(Keyword, "OPTIMUM")) {
-            if (!sscanf(strtok(0, Delimiters), "%lf", &Optimum))
-                eprintf("(OPTIMUM): real expected");
-            Optimum = floor(Optimum + 0.5);
-        } else if (!strcmp(Keyword, "PI_FILE")) {
-            if (!(PiFileName = GetFileName(0)))
-                eprintf("(PI_FILE): string expected");
-        } else if (!strcmp(Keyword, "PRECISION")) {
-            if (!sscanf(strtok(0, Delimiters), "%ld", &Precision))
-                eprintf("(PRECISION): integer expected");
-        } else if (!strcmp(Keyword, "PROBLEM_FILE")) {
-            if (!(ProblemFileName = GetFileName(0)))
-                eprintf("(PROBLEM_FILE): string expected");
-        } else if (!strcmp(Keyword, "RESTRICTED_SEARCH")) {
-            if (Token = strtok(0, Delimiters)) {
-                for (i = 0; i < strlen(Token); i++)
-                    Token[i] = (char) toupper(Token[i]);
-                if (!strcmp(Token, "YES"))
-                    RestrictedSearch = 1;
-                else if (!strcmp(Token, "NO"))
-                    RestrictedSearch = 0;
-                else
-                    Token = 0;
-            }
-            if (!Token)
-                eprintf("(RESTRICTED_SEARCH): YES or NO expected");
-        } else if (!strcmp(Keyword, "RUNS")) {
-            if (sscanf(strtok(0, Delimiters), "%ld", &Runs)) {
-                if (Runs <= 0)
-                    eprintf("(RUNS): positive integer expected");
-            } else
-                eprintf("(RUNS): integer expected");
-        } else if (!strcmp(Keyword, "SEED")) {
-            if (!sscanf(strtok(0, Delimiters), "%u", &Seed))
-                eprintf("(SEED): integer expected");
-        } else if (!strcmp(Keyword, "SUBGRADIENT")) {
-            if (Token = strtok(0, Delimiters)) {
-                for (i = 0; i < strlen(Token); i++)
-                    Token[i] = (char) toupper(Token[i]);
-                if (!strcmp(Token, "YES"))
-                    Subgradient = 1;
-                else if (!strcmp(Token, "NO"))
-                    Subgradient = 0;
-                else
-                    Token = 0;
-            }
-            if (!Token)
-                eprintf("(SUBGRADIENT): YES or NO expected");
-        } else if (!strcmp(Keyword, "TOUR_FILE")) {
-            if (!(TourFileName = GetFileName(0)))
-                eprintf("(TOUR_FILE): string expected");
-        } else if (!strcmp(Keyword, "OUTPUT_FILE")) {
-            if (!(OutputFileName = GetFileName(0)))
-                eprintf("OUTPUT_FILE: string expected");
-            else if (!(OutputFile = freopen(OutputFileName, "w", stdout)))
-                eprintf("Cannot open OUTPUT_FILE: \"%s\"", OutputFileName);
-        } else if (!strcmp(Keyword, "TRACE_LEVEL")) {
-            if (!sscanf(strtok(0, Delimiters), "%d", &TraceLevel))
-                eprintf("(TRACE_LEVEL): integer expected");
+        }
+    } else if (!strcmp(Keyword, "MAX_SWAPS")) {
+        if (sscanf(strtok(0, Delimiters), "%ld", &MaxSwaps)) {
+            if (MaxSwaps < 0)
+                eprintf("(MAX_SWAPS): non-negative integer expected");
         } else
-            eprintf("Unknown Keyword: %s", Keyword);
-    }
-    if (!ProblemFileName)
-        eprintf("Problem file name is missing.");
-    fclose(ParameterFile);
+            eprintf("(MAX_TRIALS): integer expected");
+    } else if (!strcmp(Keyword, "MAX_TRIALS")) {
+        if (sscanf(strtok(0, Delimiters), "%ld", &MaxTrials)) {
+            if (MaxTrials <= 0)
+                eprintf("(MAX_TRIALS): positive integer expected");
+        } else
+            eprintf("(MAX_TRIALS): integer expected");
+    } else if (!strcmp(Keyword, "MERGE_TOUR_FILE_1")) {
+        if (!(MergeTourFileName[0] = GetFileName(0)))
+            eprintf("(MERGE_TOUR_FILE_1): string expected");
+    } else if (!strcmp(Keyword, "MERGE_TOUR_FILE_2")) {
+        if (!(MergeTourFileName[1] = GetFileName(0)))
+            eprintf("(MERGE_TOUR_FILE_2): string expected");
+    } else if (!strcmp(Keyword, "MERGE_TOURS")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &MergeTourCount))
+            eprintf("(MERGE_TOURS): integer expected");
+        if (MergeTourCount < 0)
+            eprintf("(MERGE_TOURS): non-negative integer expected");
+    } else if (!strcmp(Keyword, "MOVE_TYPE")) {
+        if (!sscanf(strtok(0, Delimiters), "%d", &MoveType))
+            eprintf("(MOVE_TYPE): integer expected");
+        if (MoveType < 2 || MoveType > 7)
+            eprintf("(MOVE_TYPE): 2, 3, 4 or 5 expected");
+    } else if (!strcmp(Keyword, "MULTI_LEVEL")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &MultiLevels))
+            eprintf("(MULTI_LEVEL): integer expected");
+        if (MultiLevels < 0)
+            eprintf("(MULTI_LEVEL): non-negative integer expected");
+    } else if (!strcmp(Keyword, "OPTIMUM")) {
+        if (!sscanf(strtok(0, Delimiters), "%lf", &Optimum))
+            eprintf("(OPTIMUM): real expected");
+        Optimum = floor(Optimum + 0.5);
+    } else if (!strcmp(Keyword, "PARTITIONING")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "KARP"))
+                Partitioning = KARP;
+            else if (!strcmp(Token, "KMEANS"))
+                Partitioning = KMEANS;
+            else if (!strcmp(Token, "NO"))
+                Partitioning = NO_PARTITIONING;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(PARTITIONING): KARP, KMEANS or NO expected");
+        if ((Token = strtok(0, Delimiters)) &&
+            (!sscanf(Token, "%ld", &PartitionSize) || PartitionSize < 1))
+            eprintf("(PARTITIONING): positive integer expected");
+    } else if (!strcmp(Keyword, "PARTITION_CROSSOVER")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "YES"))
+                PartitionCrossoverUsed = 1;
+            else if (!strcmp(Token, "NO"))
+                PartitionCrossoverUsed = 0;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(PARTITION_CROSSOVER): YES or NO expected");
+    } else if (!strcmp(Keyword, "PI_FILE")) {
+        if (!(PiFileName = GetFileName(0)))
+            eprintf("(PI_FILE): string expected");
+    } else if (!strcmp(Keyword, "PORTFOLIO_FILE")) {
+        free(PortfolioFileName);
+        if (!(PortfolioFileName = GetFileName(0)))
+            eprintf("(PORTFOLIO_FILE): string expected");
+    } else if (!strcmp(Keyword, "PORTFOLIO_MARGIN")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%lf", &PortfolioMargin))
+            eprintf("(PORTFOLIO_MARGIN): real expected");
+        if (PortfolioMargin < 0)
+            eprintf("(PORTFOLIO_MARGIN): non-negative real expected");
+    } else if (!strcmp(Keyword, "PRECISION")) {
+        if (!sscanf(strtok(0, Delimiters), "%ld", &Precision))
+            eprintf("(PRECISION): integer expected");
+    } else if (!strcmp(Keyword, "PROBLEM_FILE")) {
+        free(ProblemFileName);
+        if (!(ProblemFileName = GetFileName(0)))
+            eprintf("(PROBLEM_FILE): string expected");
+    } else if (!strcmp(Keyword, "RESTRICTED_SEARCH")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "YES"))
+                RestrictedSearch = 1;
+            else if (!strcmp(Token, "NO"))
+                RestrictedSearch = 0;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(RESTRICTED_SEARCH): YES or NO expected");
+    } else if (!strcmp(Keyword, "RUNS")) {
+        if (sscanf(strtok(0, Delimiters), "%ld", &Runs)) {
+            if (Runs <= 0)
+                eprintf("(RUNS): positive integer expected");
+        } else
+            eprintf("(RUNS): integer expected");
+    } else if (!strcmp(Keyword, "SEED")) {
+        if (!sscanf(strtok(0, Delimiters), "%u", &Seed))
+            eprintf("(SEED): integer expected");
+    } else if (!strcmp(Keyword, "SERVER")) {
+        free(ServerName);
+        if (!(ServerName = GetFileName(0)))
+            eprintf("(SERVER): string expected");
+    } else if (!strcmp(Keyword, "SERVER_QUEUE")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &ServerQueue))
+            eprintf("(SERVER_QUEUE): integer expected");
+        if (ServerQueue < 1)
+            eprintf("(SERVER_QUEUE): positive integer expected");
+    } else if (!strcmp(Keyword, "SERVER_WORKERS")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%d", &ServerWorkers))
+            eprintf("(SERVER_WORKERS): integer expected");
+        if (ServerWorkers < 1)
+            eprintf("(SERVER_WORKERS): positive integer expected");
+    } else if (!strcmp(Keyword, "SUBGRADIENT")) {
+        if (Token = strtok(0, Delimiters)) {
+            for (i = 0; i < strlen(Token); i++)
+                Token[i] = (char) toupper(Token[i]);
+            if (!strcmp(Token, "YES"))
+                Subgradient = 1;
+            else if (!strcmp(Token, "NO"))
+                Subgradient = 0;
+            else
+                Token = 0;
+        }
+        if (!Token)
+            eprintf("(SUBGRADIENT): YES or NO expected");
+    } else if (!strcmp(Keyword, "SUBPROBLEM_SIZE")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%ld", &SubproblemSize))
+            eprintf("(SUBPROBLEM_SIZE): integer expected");
+        if (SubproblemSize < 0)
+            eprintf("(SUBPROBLEM_SIZE): non-negative integer expected");
+    } else if (!strcmp(Keyword, "SWEEP_FILE")) {
+        free(SweepFileName);
+        if (!(SweepFileName = GetFileName(0)))
+            eprintf("(SWEEP_FILE): string expected");
+    } else if (!strcmp(Keyword, "TOUR_FILE")) {
+        if (!(TourFileName = GetFileName(0)))
+            eprintf("(TOUR_FILE): string expected");
+    } else if (!strcmp(Keyword, "TOUR_FILE_INTERVAL")) {
+        if (!(Token = strtok(0, Delimiters)) ||
+            !sscanf(Token, "%lf", &TourFileInterval))
+            eprintf("TOUR_FILE_INTERVAL: real expected");
+        if (TourFileInterval < 0)
+            eprintf("TOUR_FILE_INTERVAL: non-negative real expected");
+    } else if (!strcmp(Keyword, "OUTPUT_FILE")) {
+        if (!(OutputFileName = GetFileName(0)))
+            eprintf("OUTPUT_FILE: string expected");
+        else if (!OutputFile &&
+                 !(OutputFile = freopen(OutputFileName, "w", stdout)))
+            eprintf("Cannot open OUTPUT_FILE: \"%s\"", OutputFileName);
+    } else if (!strcmp(Keyword, "TRACE_LEVEL")) {
+        if (!sscanf(strtok(0, Delimiters), "%d", &TraceLevel))
+            eprintf("(TRACE_LEVEL): integer expected");
+    } else
+        eprintf("Unknown Keyword: %s", Keyword);
+    return 1;
 }
 
 static char *GetFileName(char *Line) {
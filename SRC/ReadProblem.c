@@ -145,9 +145,8 @@
    A tour is specified in this section. The tour is given by a list of integers
    giving the sequence in which the nodes are visited in the tour. The tour is
    terminated by a -1. Note: In contrast to the TSPLIB format, only one tour can 
-   be given in this section. The tour is used to limit the search (the last edge 
-   to be removed in a non-gainful move must not belong to the tour). In addition, 
-   the Alpha field of its edges is set to zero.
+   be given in this section. The tour is used as the initial tour of the first
+   trial of each run, unless INITIAL_TOUR_FILE is given.
 
    EDGE_WEIGHT_SECTION :
    The edge weights are given in the format specifies by the EDGE_WEIGHT_FORMAT 
@@ -156,6 +155,7 @@
 */
 
 static const int MaxMatrixDimension = 2000;
+static int TreeDepth, TreeLambda;       /* The shape of SwapTree */
 static const char Delimiters[] = " :=\n\t\r\f\v";
 
 static void CheckSpecificationPart();
@@ -197,7 +197,9 @@ void ReadProblem() {
     Segment *S, *SPrev;
     char *Line, *Keyword;
 
-    if (!(ProblemFile = fopen(ProblemFileName, "r")))
+    if (!(ProblemFile = ProblemData ?
+          fmemopen(ProblemData, strlen(ProblemData), "r") :
+          fopen(ProblemFileName, "r")))
         eprintf("Cannot open %s", ProblemFileName);
     FreeStructures();
     WeightType = WeightFormat = -1;
@@ -255,35 +257,54 @@ void ReadProblem() {
     assert(BetterTour = (long *) calloc((Dimension + 1), sizeof(long)));
     assert(SwapStack =
            (SwapRecord *) malloc((Dimension + 10) * sizeof(SwapRecord)));
-    assert(HTable = (HashTable *) malloc(sizeof(HashTable)));
+    if (!HTable)
+        assert(HTable = (HashTable *) malloc(sizeof(HashTable)));
     assert(Rand = (int *) malloc((Dimension + 1) * sizeof(int)));
 
-    assert(BestImprovingMoves  = (ImprovingMove *) malloc(sizeof(ImprovingMove)));
+    if (!BestImprovingMoves)
+        assert(BestImprovingMoves  = (ImprovingMove *) malloc(sizeof(ImprovingMove)));
 
     if (SW) {
-
-        assert(BestSwapTree = (SwapMove *) malloc(sizeof(SwapMove)));
+        if (!BestSwapTree)
+            assert(BestSwapTree = (SwapMove *) malloc(sizeof(SwapMove)));
         BestSwapTree->id = -1;
         BestSwapTree->Gain = LONG_MIN;
         BestSwapTree->parent = NULL;
 
-        idMove = 0;
-        printf("Creating Tree & Queue for SW moves ... \n");
-        SwapTree = CreateSwapMoveTree(MaxDepth + 1, Lambda, 0);
-        assert(Queue = (SwapMove **) malloc(sizeof(SwapMove *) * (pow(Lambda, MaxDepth))));
-        printf("End\n");
+        /* The tree of a previous problem is reused if it has the same shape */
+        if (SwapTree && (TreeDepth != (SwStrategy == BEAM ? 1 : MaxDepth + 1) ||
+                         TreeLambda != Lambda)) {
+            FreeSwapMove(&SwapTree);
+            free(Queue);
+            Queue = 0;
+        }
+        if (!SwapTree) {
+            idMove = 0;
+            TreeDepth = SwStrategy == BEAM ? 1 : MaxDepth + 1;
+            TreeLambda = Lambda;
+            if (SwStrategy == BEAM)
+                /* SwNeighborhoodBeam uses only the root of the tree */
+                SwapTree = CreateSwapMoveTree(1, Lambda, 0);
+            else {
+                printf("Creating Tree & Queue for SW moves ... \n");
+                SwapTree = CreateSwapMoveTree(MaxDepth + 1, Lambda, 0);
+                assert(Queue = (SwapMove **) malloc(sizeof(SwapMove *) * CountSwapMoveTreeNodes(SwapTree)));
+                printf("End\n");
+            }
+        }
 
-        assert(NegativeSwapList = (SwapMove *) malloc(sizeof(SwapMove)));
+        if (!NegativeSwapList)
+            assert(NegativeSwapList = (SwapMove *) malloc(sizeof(SwapMove)));
     }
 
 
     if (Seed == 0)
         Seed = 1;
-    srand(Seed);
+    SRandom(Seed);
     for (i = 1; i <= Dimension; i++)
-        Rand[i] = rand();
+        Rand[i] = Random();
     HashInitialize(HTable);
-    srand(Seed);
+    SRandom(Seed);
     Swaps = 0;
     MakeHeap(Dimension);
     if (MaxCandidates < 0)
@@ -337,8 +358,7 @@ void ReadProblem() {
         MoveType = 5;
     if (InputTourFileName)
         ReadTour(InputTourFileName, &InputTourFile);
-    if (InitialTourFileName)
-        ReadTour(InitialTourFileName, &InitialTourFile);
+    ReadInitialTours();
     for (i = 0; i <= 1; i++)
         if (MergeTourFileName[i])
             ReadTour(MergeTourFileName[i], &MergeTourFile[i]);
@@ -361,6 +381,7 @@ void ReadProblem() {
         case 7:
             BestMove = Best2OptMoveSWBest;
     }
+    BacktrackMove = 0;
     switch (BacktrackMoveType) {
         case 2:
             BacktrackMove = Backtrack2OptMove;
@@ -1019,7 +1040,7 @@ static void Read_TOUR_SECTION(FILE **File) {
         else {
             if (File == &InputTourFile)
                 Last->OptimumSuc = N;
-            else if (File == &InitialTourFile)
+            else if (File == &InitialTourFile || File == &ProblemFile)
                 Last->InitialSuc = N;
             else if (File == &MergeTourFile[0])
                 Last->MergeSuc[0] = N;
@@ -1032,7 +1053,7 @@ static void Read_TOUR_SECTION(FILE **File) {
             N->V = 1;
             if (File == &InputTourFile)
                 Last->OptimumSuc = N;
-            else if (File == &InitialTourFile)
+            else if (File == &InitialTourFile || File == &ProblemFile)
                 Last->InitialSuc = N;
             else if (File == &MergeTourFile[0])
                 Last->MergeSuc[0] = N;
@@ -1045,7 +1066,7 @@ static void Read_TOUR_SECTION(FILE **File) {
     if (Last) {
         if (File == &InputTourFile)
             Last->OptimumSuc = First;
-        else if (File == &InitialTourFile)
+        else if (File == &InitialTourFile || File == &ProblemFile)
             Last->InitialSuc = First;
         else if (File == &MergeTourFile[0])
             Last->MergeSuc[0] = First;
@@ -11,6 +11,9 @@
    Recording a better tour in the BetterTour array when the problem is 
    asymmetric requires special treatment since the number of nodes has
    been doubled.  
+
+   The tour is now the best tour, so the trial log is cleared (see
+   ClearTrialLog).
 */
 
 void RecordBetterTour()
@@ -31,4 +34,5 @@ void RecordBetterTour()
         N->NextBestSuc = N->BestSuc;
         N->BestSuc = N->Suc;
     }
+    ClearTrialLog();
 }
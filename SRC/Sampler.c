@@ -0,0 +1,68 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file sample the candidate edges of a node for the
+   stochastic walk (SW), without replacement and according to SAMPLING_BIAS.
+
+   StartSampler(S, Count) starts a sampling of Count candidates (indices
+   0 .. Count-1). NextSample(S) draws one of the remaining indices, removes
+   it, and returns it. Let k be a random rank and let Left be the number of
+   remaining indices. The index drawn is the k-th smallest remaining index,
+   where k is truncated to Left - 1, and
+
+       k = 0                              when SAMPLING_BIAS = LKH,
+       k = Random() % Count               when SAMPLING_BIAS = RANDOM,
+       k = geometric, P(k) = 2^-(k+1)     when SAMPLING_BIAS = BIASED.
+
+   These are the distributions of the original sampling code, which kept an
+   array of the remaining indices in increasing order and moved each drawn
+   index to its end.
+
+   The remaining indices are kept as a bit mask. Since the sampler is used
+   by the recursive SW searches, each caller keeps its own sampler, so
+   there is no allocation per call. A draw does not scan or shift an
+   array. The geometric rank is taken as the number of trailing zeros of
+   a random number, which needs no call of log. The k-th remaining index is
+   found by skipping k set bits, which takes O(k) time on average (O(1)
+   for BIASED and LKH).
+
+   Only the first SamplerWords * 64 candidates of a node are sampled.
+*/
+
+void StartSampler(CandidateSampler * S, int Count)
+{
+    int i;
+
+    if (Count > SamplerWords * 64)
+        Count = SamplerWords * 64;
+    S->Count = S->Left = Count;
+    for (i = 0; i < SamplerWords; i++)
+        S->Mask[i] = Count >= 64 * (i + 1) ? ~0ULL :
+            Count <= 64 * i ? 0 : (1ULL << (Count - 64 * i)) - 1;
+}
+
+int NextSample(CandidateSampler * S)
+{
+    unsigned long long M;
+    unsigned R;
+    int k, w, Bits;
+
+    if (S->Left == 0)
+        return -1;
+    if (SamplingBiasUsed == 2) {
+        R = Random();
+        k = R ? __builtin_ctz(R) : 31;
+    } else if (SamplingBiasUsed == 1)
+        k = (int) (Random() % S->Count);
+    else
+        k = 0;
+    if (k > S->Left - 1)
+        k = S->Left - 1;
+    for (w = 0; k >= (Bits = __builtin_popcountll(S->Mask[w])); w++)
+        k -= Bits;
+    for (M = S->Mask[w]; k > 0; k--)
+        M &= M - 1;
+    S->Mask[w] &= ~(M & -M);
+    S->Left--;
+    return 64 * w + __builtin_ctzll(M);
+}
@@ -0,0 +1,79 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The SegmentDoubleBridgeKick function perturbs the current tour by a
+   double-bridge move confined to a short segment of the tour.
+
+   A random node, a, is chosen, and three cut positions, p1 < p2 < p3, are
+   chosen at random among the SegmentLength nodes that follow a on the tour.
+   The tour
+
+       a B C D e, where B = (Suc(a) ... node p1), C = (node p1+1 ... node p2),
+                    D = (node p2+1 ... node p3) and e = Suc(node p3),
+
+   is changed into
+
+       a D C B e.
+
+   The move removes the four edges (a,Suc(a)), (p1,p1+1), (p2,p2+1) and
+   (p3,e) and adds four new edges, without reversing any part of the tour.
+   The removed and added edges form two alternating cycles, so the move is
+   non-sequential and cannot be undone by a single sequential move of the
+   Lin-Kernighan search. (Swapping only two segments, a C B D, is a pure
+   sequential 3-opt move, which the search would simply undo, returning to
+   the tour from which the kick started.) Fixed edges are never removed,
+   and forbidden edges (ATSP) are never added. If no legal kick is found
+   within a limited number of attempts, the tour is left unchanged.
+
+   The move is made by four 2-opt moves (see KickSwap): B C D is reversed
+   as a whole, and then each of D, C and B is reversed back (X' denotes
+   the reversal of X). Thus, Rank and Hash are maintained by Flip, and the
+   kick is logged, so that it can be undone when the best tour is restored
+   (see RestoreBestTour).
+
+   Only the eight end nodes of the four segments get new neighbors. These
+   are the nodes made active when the LinKernighan function starts from the
+   kicked tour.
+
+   The function is called from the ChooseInitialTour function.
+*/
+
+static const long SegmentLength = 100;
+static const int MaxAttempts = 50;
+
+void SegmentDoubleBridgeKick()
+{
+    Node *a, *b1, *b2, *c1, *c2, *d1, *d2, *e, *N;
+    long L, p1, p2, p3, i, Attempt;
+
+    if (Dimension < 8)
+        return;
+    L = SegmentLength < Dimension - 2 ? SegmentLength : Dimension - 2;
+    for (Attempt = 1; Attempt <= MaxAttempts; Attempt++) {
+        a = &NodeSet[1 + Random() % Dimension];
+        b1 = a->Suc;
+        if (Fixed(a, b1))
+            continue;
+        p1 = 1 + Random() % (L - 2);
+        p2 = p1 + 1 + Random() % (L - p1 - 1);
+        p3 = p2 + 1 + Random() % (L - p2);
+        for (i = 1, N = b1; i < p1; i++, N = N->Suc);
+        b2 = N;
+        c1 = b2->Suc;
+        for (; i < p2; i++, N = N->Suc);
+        c2 = N;
+        d1 = c2->Suc;
+        for (; i < p3; i++, N = N->Suc);
+        d2 = N;
+        e = d2->Suc;
+        if (Fixed(b2, c1) || Fixed(c2, d1) || Fixed(d2, e) ||
+            Forbidden(a, d1) || Forbidden(d2, c1) || Forbidden(c2, b1) ||
+            Forbidden(b2, e))
+            continue;
+        KickSwap(a, b1, e);     /* a D' C' B' e */
+        KickSwap(a, d2, c2);    /* a D C' B' e */
+        KickSwap(d2, c2, b2);   /* a D C B' e */
+        KickSwap(c2, b2, e);    /* a D C B e */
+        return;
+    }
+}
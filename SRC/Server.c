@@ -0,0 +1,229 @@
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "INCLUDE/LK.h"
+
+/*
+   The Serve function runs the program as a server (SERVER = <string>) that
+   solves problems on request. The solver process stays alive between
+   requests. So a request costs only the time of reading the problem and
+   of the search, and no process start-up. The preprocessing is also saved
+   if the same problem is submitted again.
+
+   Protocol. A request is a sequence of lines, terminated by a line
+   containing END (or by the end of input). Each line is a parameter
+   setting in the format of the parameter file, for example RUNS = 3 or
+   DEADLINE = 2.5. The settings override those of the parameter file, for
+   this request only. The problem is given either by PROBLEM_FILE, or
+   inline by a line containing PROBLEM_SECTION, followed by the problem in
+   TSPLIB format up to and including its EOF line.
+
+   The response consists of a line
+
+       TOUR <cost> <node> <node> ... <node>
+
+   for each new best tour found, followed by a result line in the format of
+   BATCH_RESULT_FILE. If a request is invalid, the response is the error
+   message. The connection is then closed, and the worker is restarted.
+   More than one request may be sent on the same connection.
+
+   Workers. SERVER_WORKERS worker processes are forked, which accept
+   requests on the Unix domain socket named by SERVER. Each worker has its
+   own solver state (the global variables of the program) and serves one
+   request at a time. The socket's queue holds at most SERVER_QUEUE waiting
+   requests. The master process restarts a worker that terminates. With
+   SERVER = -, requests are read from standard input and served one after
+   the other by the process itself. The output of the solver is then
+   written to standard error.
+
+   Preprocessing cache. A worker keeps the state after the preprocessing
+   of its last problem in memory. If a request has the same problem text
+   and the same parameters of the preprocessing, the ascent is not repeated
+   (see PreprocessingCache).
+*/
+
+static FILE *Out;               /* The stream of responses */
+static char *Data = 0;          /* The text of the problem of the request */
+static size_t DataSize, DataSpace = 0;
+
+static void RunWorker(int Listener);
+static void StartWorker(int Listener);
+static void ServeRequests(FILE * In, FILE * Output);
+static int ReadRequest(FILE * In);
+static void Append(char *Text);
+static void SendTour(double Cost);
+
+void Serve()
+{
+    struct sockaddr_un Address;
+    int Listener, Status, i;
+
+    signal(SIGPIPE, SIG_IGN);
+    if (!strcmp(ServerName, "-")) {
+        FILE *Output = fdopen(dup(1), "w");
+        dup2(2, 1);
+        ServeRequests(stdin, Output);
+        fclose(Output);
+        return;
+    }
+    if (strlen(ServerName) >= sizeof(Address.sun_path))
+        eprintf("SERVER: Name too long: %s", ServerName);
+    if ((Listener = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+        eprintf("SERVER: Cannot create socket");
+    memset(&Address, 0, sizeof(Address));
+    Address.sun_family = AF_UNIX;
+    strcpy(Address.sun_path, ServerName);
+    unlink(ServerName);
+    if (bind(Listener, (struct sockaddr *) &Address, sizeof(Address)) ||
+        listen(Listener, ServerQueue))
+        eprintf("SERVER: Cannot listen on %s", ServerName);
+    printf("Serving on %s with %d worker(s)\n", ServerName, ServerWorkers);
+    fflush(stdout);
+    for (i = 0; i < ServerWorkers; i++)
+        StartWorker(Listener);
+    /* Restart workers that terminate */
+    for (;;) {
+        if (wait(&Status) > 0)
+            StartWorker(Listener);
+        else if (errno != EINTR)
+            break;
+    }
+}
+
+static void StartWorker(int Listener)
+{
+    pid_t Pid;
+
+    if ((Pid = fork()) < 0)
+        eprintf("SERVER: Cannot create worker");
+    if (Pid == 0) {
+        RunWorker(Listener);
+        exit(0);
+    }
+}
+
+/*
+   The RunWorker function is executed by each worker process. The error
+   output is sent to the client while a request is served, so that the
+   client receives the message of an invalid request.
+*/
+
+static void RunWorker(int Listener)
+{
+    int Client, Error = dup(2);
+    FILE *In, *Output;
+
+    for (;;) {
+        if ((Client = accept(Listener, 0, 0)) < 0) {
+            if (errno == EINTR)
+                continue;
+            eprintf("SERVER: Cannot accept requests");
+        }
+        In = fdopen(Client, "r");
+        Output = fdopen(dup(Client), "w");
+        dup2(Client, 2);
+        ServeRequests(In, Output);
+        dup2(Error, 2);
+        fclose(Output);
+        fclose(In);
+    }
+}
+
+static void ServeRequests(FILE * In, FILE * Output)
+{
+    Out = Output;
+    TourCallback = SendTour;
+    while (ReadRequest(In)) {
+        Solve(Out, 0);
+        fflush(Out);
+    }
+    TourCallback = 0;
+}
+
+/*
+   The ReadRequest function reads the next request and sets the parameters
+   and ProblemData accordingly. It returns 0 if there are no more requests.
+*/
+
+static int ReadRequest(FILE * In)
+{
+    char *Line, Keyword[32], *FileName;
+    FILE *File;
+    int Lines = 0, i, c;
+
+    ResetParameters();
+    ProblemData = 0;
+    DataSize = 0;
+    while ((Line = ReadLine(In))) {
+        Lines++;
+        if (sscanf(Line, " %31[A-Za-z_0-9]", Keyword) != 1)
+            continue;
+        for (i = 0; Keyword[i]; i++)
+            Keyword[i] = (char) toupper(Keyword[i]);
+        if (!strcmp(Keyword, "END"))
+            break;
+        if (strcmp(Keyword, "PROBLEM_SECTION")) {
+            ReadParameter(Line);
+            continue;
+        }
+        /* An inline problem */
+        while ((Line = ReadLine(In))) {
+            Append(Line);
+            Append("\n");
+            if (sscanf(Line, " %31[A-Za-z_]", Keyword) == 1 &&
+                !strcmp(Keyword, "EOF"))
+                break;
+        }
+        free(ProblemFileName);
+        assert(ProblemFileName = (char *) malloc(2));
+        strcpy(ProblemFileName, "-");
+        ProblemData = Data;
+    }
+    if (Lines == 0)
+        return 0;
+    if (!ProblemData) {
+        if (!ProblemFileName)
+            eprintf("SERVER: Request without problem");
+        /* Read the problem file into memory */
+        FileName = ProblemFileName;
+        if (!(File = fopen(FileName, "r")))
+            eprintf("Cannot open %s", FileName);
+        while ((c = fgetc(File)) != EOF) {
+            char S[2] = { (char) c, '\0' };
+            Append(S);
+        }
+        fclose(File);
+        ProblemData = Data;
+    }
+    return 1;
+}
+
+/*
+   The Append function appends text to the problem text, Data.
+*/
+
+static void Append(char *Text)
+{
+    size_t Length = strlen(Text);
+
+    if (DataSize + Length + 1 > DataSpace) {
+        DataSpace = 2 * (DataSize + Length + 1);
+        assert(Data = (char *) realloc(Data, DataSpace));
+    }
+    strcpy(Data + DataSize, Text);
+    DataSize += Length;
+}
+
+static void SendTour(double Cost)
+{
+    long i, n = ProblemType != ATSP ? Dimension : Dimension / 2;
+
+    fprintf(Out, "TOUR %0.0f", Cost);
+    for (i = 1; i <= n; i++)
+        fprintf(Out, " %ld", BestTour[i]);
+    fprintf(Out, "\n");
+    fflush(Out);
+}
@@ -0,0 +1,261 @@
+#include "INCLUDE/LK.h"
+
+/*
+   This file contains the global variables of the program and the Solve
+   function, which solves a problem given by the current parameters. It is
+   used both by the program (LKmain) and by the library (liblkh).
+*/
+
+/* Declarations of all global variables */
+
+long *BestTour, Dimension, MaxCandidates, AscentCandidates, InitialPeriod,
+        InitialStepSize, Precision, Runs, MaxTrials, MaxSwaps;
+double BestCost, WorstCost, Excess, Optimum, SwNeighborhoodStartTime, SwNeighborhoodLimitTimeExceed, PrintGapTime,
+        TourFileInterval, CheckpointInterval, Deadline, EndTime;
+double AutoTuneFraction, PortfolioMargin, BackboneFraction;
+long SweepCandidates, BackboneRuns, SubproblemSize, PartitionSize;
+unsigned int Seed;
+int ServerQueue, ServerWorkers, MergeTourCount, PartitionCrossoverUsed,
+        Partitioning, MultiLevels;
+int Subgradient, TraceLevel, KickType, Gain23Threads, LKThreads, SwThreads, SwStrategy, BeamWidth, MoveType, BacktrackMoveType, RestrictedSearch, SW, Lambda, TrialTimeBudget, MaxDepth,
+        GainCriterionUsed, idMove, Gain23Used, SamplingBiasUsed, IntensificationDiversificationBest, IntensificationDiversificationAny,
+        maxCoNodes;
+__thread int coNodes;
+volatile int ExitSwNeighborhood;
+
+ImprovingMove *BestImprovingMoves;
+Node *NodeSet, *FirstNode, *FirstActive, *LastActive, *FirstTouched, **Heap;
+__thread SwapRecord *SwapStack;
+SwapMove *SwapTree;
+__thread SwapMove *BestSwapTree;
+SwapMove **NegativeSwapList;
+__thread SwapMove **Queue;
+
+Neighborhood *NegativeNeighbors;
+__thread long Swaps;
+long Norm, M, GroupSize, Groups, Trial, *BetterTour, *CacheVal,
+        *CacheSig, *CostMatrix;
+double BetterCost, CurrentCost, LowerBound;
+__thread unsigned long Hash;
+int *Rand;
+__thread int Reversed, WorkerThread;
+Segment *FirstSegment;
+HashTable *HTable;
+
+FILE *ParameterFile, *ProblemFile, *PiFile, *TourFile, *OutputFile,
+        *InputTourFile, *CandidateFile, *InitialTourFile, *MergeTourFile[2];
+char *ParameterFileName, *ProblemFileName, *PiFileName, *TourFileName, *OutputFileName,
+        *InputTourFileName, *CandidateFileName, *InitialTourFileName,
+        *CheckpointFileName, *BatchFileName, *BatchResultFileName,
+        *ServerName, *SweepFileName, *AutoTuneFileName,
+        *AutoTuneResultFileName, *PortfolioFileName, *MergeTourFileName[2];
+char *ProblemData;
+char *Name, *Type, *EdgeWeightType, *EdgeWeightFormat, *EdgeDataFormat,
+        *NodeCoordType, *DisplayDataType;
+int ProblemType = -1, WeightType = -1, WeightFormat = -1, CoordType =
+        NO_COORDS, CandidateSetSymmetric = 0;
+
+long (*Distance)(Node *Na, Node *Nb);
+
+long (*C)(Node *Na, Node *Nb);
+
+long (*D)(Node *Na, Node *Nb);
+
+long (*c)(Node *Na, Node *Nb);
+
+Node *(*BestMove)(Node *t1, Node *t2, long *G0, long *Gain);
+
+Node *(*BacktrackMove)(Node *t1, Node *t2, long *G0, long *Gain);
+
+void (*TourCallback)(double Cost);
+
+jmp_buf *ErrorReturn;
+char ErrorMessage[256];
+
+/*
+   The Solve function solves the problem given by the current parameters
+   and reports the results. If ResultFile is not 0, a result line for the
+   problem is also written to ResultFile (batch, sweep and server mode),
+   preceded by Label if it is not 0.
+*/
+
+void Solve(FILE *ResultFile, char *Label) {
+    long TrialSum, MinTrial, Successes, Run, RunsMade, Candidates;
+    double Cost, CostSum, Time, TimeSum, MinTime, ChildCost;
+    double StartTime, LastTime;
+    int Resumed;
+
+    StartTime = LastTime = GetTime();
+    EndTime = Deadline > 0 ? GetWallTime() + Deadline : 0;
+    TrialSum = Successes = 0;
+    CostSum = TimeSum = 0.0;
+    MinTrial = LONG_MAX;
+    MinTime = DBL_MAX;
+
+    ReadProblem();
+    Run = 1;
+    /* The candidate sets of a sweep are shared by all configurations */
+    Candidates = MaxCandidates;
+    if (SweepCandidates > MaxCandidates)
+        MaxCandidates =
+            SweepCandidates < Dimension ? SweepCandidates : Dimension;
+    if ((Resumed = ReadCheckpoint(&Run, &TrialSum, &MinTrial, &Successes,
+                                  &CostSum, &TimeSum, &MinTime)) ||
+        RestorePreprocessing(&Run, &TrialSum, &MinTrial, &Successes,
+                             &CostSum, &TimeSum, &MinTime)) {
+        /* Resume the job from the checkpoint, or reuse the preprocessing */
+        if (Norm == 0) {
+            Runs = 0;
+            PrintBestTour();
+        }
+        if (Resumed)
+            printf("Resumed from %s at run %ld\n", CheckpointFileName, Run);
+        else
+            printf("Preprocessing reused\n");
+        printf("Preprocessing time = %0.0f sec.\n\n", GetTime() - LastTime);
+        fflush(stdout);
+    } else {
+        if (Partitioning)
+            SolvePartitions();
+        else
+            CreateCandidateSet();
+        printf("Preprocessing time = %0.0f sec.\n\n",
+               GetTime() - LastTime);
+        fflush(stdout);
+        if (Norm != 0) {
+            BestCost = DBL_MAX;
+            WorstCost = -DBL_MAX;
+            Successes = 0;
+        } else {
+            /* The ascent has solved the problem! */
+            Successes = 1;
+            Runs = 0;
+            RecordBetterTour();
+            RecordBestTour();
+            BestCost = WorstCost = Cost = CostSum = LowerBound;
+            PrintBestTour();
+        }
+        TimeSum = 0;
+        WriteCheckpoint(Run, TrialSum, MinTrial, Successes, CostSum,
+                        TimeSum, MinTime, 1);
+        SavePreprocessing(Run, TrialSum, MinTrial, Successes, CostSum,
+                          TimeSum, MinTime);
+    }
+    if (MaxCandidates != Candidates) {
+        MaxCandidates = Candidates;
+        TruncateCandidateSets(MaxCandidates);
+    }
+    if (Runs == 0 && Norm != 0) {
+        /* Only the preprocessing is wanted (see AutoTune) */
+        FlushBestTour();
+        return;
+    }
+    ClearMergeTours();
+    ClearCrossover();
+    if (Run == 1)
+        MultiLevel();
+    /* Find a specified number (Runs) of local optima */
+    for (; Run <= Runs; Run++) {
+        LastTime = GetTime();
+        SetInitialTour(Run);
+        Cost = FindTour();      /* using the Lin-Kerninghan heuristics */
+        if (Cost < BestCost) {
+            RecordBestTour();
+            BestCost = Cost;
+            PrintBestTour();
+        }
+        StoreMergeTour(Cost);
+        /* Update statistics */
+        if (Cost > WorstCost)
+            WorstCost = Cost;
+        if (Cost <= Optimum)
+            Successes++;
+        Time = GetTime() - LastTime;
+        if (TraceLevel >= 1) {
+            printf("#RUN %d : Cost = %0.0f, Seed = %u, Time = %0.3f sec.\n\n",
+                   Run, Cost, Seed, Time);
+            fflush(stdout);
+        }
+        CollectBackbone(Run);
+        CostSum += Cost;
+        TrialSum += Trial;
+        if (Trial < MinTrial)
+            MinTrial = Trial;
+        TimeSum += Time;
+        if (Time < MinTime)
+            MinTime = Time;
+        SRandom(++Seed);
+        if (Cost < Optimum || (Cost == Optimum && Successes == 1)) {
+            if (Cost < Optimum) {
+                Node *N;
+                N = FirstNode;
+                while ((N = N->OptimumSuc = N->Suc) != FirstNode);
+                printf("New optimum = %f, Old optimum = %f\n", Cost,
+                       Optimum);
+                fflush(stdout);
+                Optimum = Cost;
+            }
+            PrintBestTour();
+        }
+        /* Recombine the tour with the best tour of the previous runs */
+        if ((ChildCost = PartitionCrossover(Cost)) < BestCost) {
+            RecordBestTour();
+            BestCost = ChildCost;
+            PrintBestTour();
+        }
+        if (EndTime > 0 && GetWallTime() >= EndTime && Run < Runs) {
+            printf("Deadline reached after run %ld\n", Run);
+            Runs = Run;
+        }
+        WriteCheckpoint(Run + 1, TrialSum, MinTrial, Successes, CostSum,
+                        TimeSum, MinTime, Run == Runs);
+    }
+    /* Merge the best tours of the runs (see MergeTours) */
+    if ((Cost = MergeTours()) < BestCost) {
+        RecordBestTour();
+        BestCost = Cost;
+        PrintBestTour();
+    }
+    /* Improve the best tour by solving subproblems (see SolveSubproblems) */
+    if ((Cost = SolveSubproblems()) < BestCost) {
+        RecordBestTour();
+        BestCost = Cost;
+        PrintBestTour();
+    }
+    /* Report the resuls */
+    printf("\nLAMBDA = %d MAX_CANDIDATES = %ld", Lambda, MaxCandidates);
+    //printf("\nMax Nodes Generated = %d", maxCoNodes);
+    printf("\nSuccesses/Runs = %ld/%ld \n", Successes, Runs);
+    RunsMade = Runs;
+    if (Runs == 0) {
+        Runs = 1;
+        MinTrial = 0;
+        MinTime = 0;
+    }
+    printf("Cost.min = %0.0f, Cost.avg = %0.1f, Cost.max = %0.0f\n",
+           BestCost, CostSum / Runs, WorstCost);
+    if (Optimum == -DBL_MAX)
+        Optimum = BestCost;
+    printf("Gap.min = %0.3f%%, Gap.avg = %0.3f%%, Gap.max = %0.3f%%\n",
+           (BestCost - Optimum) / Optimum * 100.0,
+           (CostSum / Runs - Optimum) / Optimum * 100.0,
+           (WorstCost - Optimum) / Optimum * 100.0);
+    printf("MinTrials = %ld, Trials.avg. = %0.1f\n", MinTrial,
+           1.0 * TrialSum / Runs);
+    printf("Time.min = %0.3f sec., Time.avg. = %0.3f sec.\n\n", MinTime,
+           TimeSum / Runs);
+    fflush(stdout);
+    FlushBestTour();
+    if (ResultFile) {
+        if (Label)
+            fprintf(ResultFile, "%s ", Label);
+        fprintf(ResultFile, "%s %s %ld %0.0f %0.1f %0.0f %0.3f %ld %ld "
+                "%0.3f\n", ProblemFileName, Name ? Name : "-",
+                ProblemType == ATSP ? Dimension / 2 :
+                ProblemType == HPP ? Dimension - 1 : Dimension,
+                BestCost, CostSum / Runs, WorstCost,
+                (BestCost - Optimum) / Optimum * 100.0, Successes,
+                RunsMade, GetTime() - StartTime);
+        fflush(ResultFile);
+    }
+}
@@ -0,0 +1,496 @@
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "INCLUDE/LK.h"
+
+/*
+   The SolvePartitions function is called by Solve instead of
+   CreateCandidateSet if the problem is to be partitioned (PARTITIONING =
+   KARP or KMEANS). It determines the pi-values and the candidate sets of
+   the nodes, and an initial tour, without an ascent on the whole problem.
+
+   The nodes are split into cells of at most PartitionSize nodes:
+
+   (1) KARP: The nodes are split recursively at the median of the longer
+       side of their bounding box [Karp (1977): Probabilistic analysis of
+       partitioning algorithms for the traveling-salesman problem in the
+       plane].
+
+   (2) KMEANS: The nodes are clustered by Lloyd's algorithm, starting from
+       the centroids of the Karp cells. A node is only compared with the
+       center of its cluster and the centers nearest to that center.
+       Clusters with too many nodes are split as in (1).
+
+   Each cell is solved as a problem of its own by a child process (see
+   SolveSubproblem), and as many processes as there are processors run at
+   a time. A process writes the pi-values, the candidate sets and the tour
+   of its cell into shared memory.
+
+   The tours of the cells are then stitched together, one cell at a time in
+   the order of the cells. A cell is joined with the previous one by the
+   cheapest exchange of an edge of the one with an edge of the other. The
+   candidate set of a node consists of its candidates in its cell, its
+   neighbors in the stitched tour, and its nearest node in the cell it was
+   joined with, if that node is nearer than one of its candidates.
+
+   The stitched tour becomes the initial tour of each run (InitialSuc), in
+   place of the tours of INITIAL_TOUR_FILE (see OverrideInitialTours), and
+   is improved by LinKernighan in the runs. The pi-values of different
+   cells do not fit together as the pi-values of an ascent on the whole
+   problem would, but they cancel out in the cost of a tour, so the search
+   is not affected by this.
+
+   The problem must be given by coordinates. Otherwise, CreateCandidateSet
+   is called.
+*/
+
+static Node **Nodes = 0;        /* The nodes, cell by cell */
+static long *Start = 0;         /* The first node of each cell in Nodes */
+static long Cells, CellSpace = 0;
+static int *CellOf = 0;         /* The cell of each node */
+static int *Nearest = 0;        /* The nearest node in a neighboring cell */
+static long *NearestCost;
+
+/* Shared with the child processes */
+static long *Pi;                /* The pi-values of the nodes */
+static long *Alpha;             /* The alpha-values of their candidates */
+static int *Cand;               /* The candidates, MaxCandidates per node */
+static int *Adj;                /* The two tour neighbors of each node */
+
+static void Split(Node ** Set, long Count);
+static void KMeans();
+static void SolveCell(long Cell);
+static void Stitch();
+static void Replace(long a, long Old, long New);
+static void AddCell(long Count);
+static int CompareX(const void *Na, const void *Nb);
+static int CompareY(const void *Na, const void *Nb);
+
+void SolvePartitions()
+{
+    Candidate *NN;
+    Node *N, *To;
+    long Workers, Running, Count, Farthest, a, b, p, i, j, k;
+    int Solved;
+    size_t Size;
+    pid_t Pid;
+    double Cost = 0, StartTime = GetWallTime();
+
+    if (Distance == Distance_EXPLICIT || Distance == Distance_1 ||
+        Distance == Distance_ATSP || ProblemType != TSP) {
+        printf("PARTITIONING: Ignored (the problem has no coordinates)\n");
+        CreateCandidateSet();
+        return;
+    }
+    assert(Nodes = (Node **) realloc(Nodes, Dimension * sizeof(Node *)));
+    assert(CellOf = (int *) realloc(CellOf, (Dimension + 1) * sizeof(int)));
+    assert(Nearest =
+           (int *) realloc(Nearest, (Dimension + 1) * sizeof(int)));
+    assert(NearestCost = (long *)
+           malloc((Dimension + 1) * sizeof(long)));
+    for (i = 0; i < Dimension; i++)
+        Nodes[i] = &NodeSet[i + 1];
+    Cells = 0;
+    if (Partitioning == KARP)
+        Split(Nodes, Dimension);
+    else
+        KMeans();
+
+    /* The pi-values and alpha-values, followed by the candidates and the
+       tour neighbors */
+    Size = (Dimension + 1) * ((MaxCandidates + 1) * sizeof(long) +
+                              (MaxCandidates + 2) * sizeof(int));
+    if ((Pi = (long *) mmap(0, Size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1,
+                            0)) == MAP_FAILED)
+        eprintf("PARTITIONING: Cannot allocate shared memory");
+    Alpha = Pi + Dimension + 1;
+    Cand = (int *) (Alpha + (Dimension + 1) * MaxCandidates);
+    Adj = Cand + (Dimension + 1) * MaxCandidates;
+
+    /* Solve the cells */
+    if ((Workers = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+        Workers = 1;
+    fflush(stdout);
+    for (k = Running = 0; k < Cells; k++) {
+        if (Start[k + 1] - Start[k] < 5)
+            continue;
+        if (Running == Workers && wait(0) > 0)
+            Running--;
+        if ((Pid = fork()) < 0)
+            eprintf("PARTITIONING: Cannot create process");
+        if (Pid == 0) {
+            SolveCell(k);
+            exit(0);
+        }
+        Running++;
+    }
+    while (wait(0) > 0);
+    for (k = 0; k < Cells; k++) {
+        Count = Start[k + 1] - Start[k];
+        Solved = Adj[2 * Nodes[Start[k]]->Id] != 0;
+        for (i = 0; i < Count; i++) {
+            a = Nodes[Start[k] + i]->Id;
+            CellOf[a] = k;
+            Nearest[a] = 0;
+            NearestCost[a] = LONG_MAX;
+            if (Solved)
+                continue;
+            /* A small cell, or a cell whose process has failed */
+            Adj[2 * a] = Nodes[Start[k] + (i + Count - 1) % Count]->Id;
+            Adj[2 * a + 1] = Nodes[Start[k] + (i + 1) % Count]->Id;
+        }
+    }
+    Stitch();
+
+    /* The pi-values and the candidate sets */
+    N = FirstNode;
+    do
+        N->Pi = Pi[N->Id];
+    while ((N = N->Suc) != FirstNode);
+    if (C == C_EXPLICIT) {
+        N = FirstNode;
+        do {
+            for (i = 1; i < N->Id; i++)
+                N->C[i] = N->C[i] * Precision + N->Pi + NodeSet[i].Pi;
+        } while ((N = N->Suc) != FirstNode);
+    }
+    N = FirstNode;
+    do {
+        a = N->Id;
+        free(N->CandidateSet);
+        assert(N->CandidateSet = NN = (Candidate *)
+               malloc((MaxCandidates + 4) * sizeof(Candidate)));
+        for (k = 0, Farthest = 0; k < MaxCandidates + 3; k++) {
+            if (k < MaxCandidates) {
+                if (!(b = Cand[a * MaxCandidates + k]))
+                    continue;
+            } else
+                b = k == MaxCandidates ? Adj[2 * a] :
+                    k == MaxCandidates + 1 ? Adj[2 * a + 1] :
+                    NearestCost[a] < Farthest ||
+                    Farthest == 0 ? Nearest[a] : 0;
+            To = &NodeSet[b];
+            if (!b || b == a)
+                continue;
+            for (j = 0; j < NN - N->CandidateSet &&
+                 N->CandidateSet[j].To != To; j++);
+            if (j < NN - N->CandidateSet)
+                continue;
+            NN->To = To;
+            NN->Cost = C == C_EXPLICIT ? C(N, To) : D(N, To);
+            NN->Alpha =
+                k < MaxCandidates ? Alpha[a * MaxCandidates + k] : 0;
+            if (k < MaxCandidates && Distance(N, To) > Farthest)
+                Farthest = Distance(N, To);
+            NN++;
+        }
+        NN->To = 0;
+    } while ((N = N->Suc) != FirstNode);
+
+    /* The stitched tour is the initial tour */
+    for (i = 0, a = 1, p = Adj[2]; i < Dimension; i++, p = a, a = b) {
+        b = Adj[2 * a] == p ? Adj[2 * a + 1] : Adj[2 * a];
+        NodeSet[a].InitialSuc = &NodeSet[b];
+        Cost += Distance(&NodeSet[a], &NodeSet[b]);
+    }
+    OverrideInitialTours();
+    Norm = 9999;
+    printf("PARTITIONING: Cells = %ld, Cost = %0.0f, Time = %0.3f sec.\n",
+           Cells, Cost, GetWallTime() - StartTime);
+    fflush(stdout);
+    munmap(Pi, Size);
+    free(NearestCost);
+}
+
+/*
+   The Split function splits the Count nodes of Set into cells of at most
+   PartitionSize nodes by Karp's method. The cells are appended to the
+   cells found so far. Set must follow the nodes of these cells in Nodes.
+*/
+
+static void Split(Node ** Set, long Count)
+{
+    double MinX, MaxX, MinY, MaxY;
+    long i;
+
+    if (Count <= PartitionSize) {
+        AddCell(Count);
+        return;
+    }
+    MinX = MaxX = Set[0]->X;
+    MinY = MaxY = Set[0]->Y;
+    for (i = 1; i < Count; i++) {
+        if (Set[i]->X < MinX)
+            MinX = Set[i]->X;
+        else if (Set[i]->X > MaxX)
+            MaxX = Set[i]->X;
+        if (Set[i]->Y < MinY)
+            MinY = Set[i]->Y;
+        else if (Set[i]->Y > MaxY)
+            MaxY = Set[i]->Y;
+    }
+    qsort(Set, Count, sizeof(Node *),
+          MaxX - MinX >= MaxY - MinY ? CompareX : CompareY);
+    Split(Set, Count / 2);
+    Split(Set + Count / 2, Count - Count / 2);
+}
+
+/*
+   The KMeans function splits the nodes into cells by k-means clustering.
+   Lloyd's algorithm starts from the Karp cells and makes at most 10
+   iterations. Each center is given its 8 nearest centers when the
+   clustering starts.
+*/
+
+#define NearCenters 8
+
+static void KMeans()
+{
+    double *X, *Y, *SumX, *SumY, *NearD, d, BestD;
+    long *Count, *Near, K, Changes, Iteration, c, e, Best, i, j;
+    Node *N;
+
+    Split(Nodes, Dimension);
+    K = Cells;
+    assert(X = (double *) malloc(4 * K * sizeof(double)));
+    Y = X + K;
+    SumX = Y + K;
+    SumY = SumX + K;
+    assert(Count = (long *) malloc(K * sizeof(long)));
+    assert(Near = (long *) malloc(K * NearCenters * sizeof(long)));
+    assert(NearD = (double *) malloc(K * NearCenters * sizeof(double)));
+    for (c = 0; c < K; c++) {
+        X[c] = Y[c] = 0;
+        for (i = Start[c]; i < Start[c + 1]; i++) {
+            X[c] += Nodes[i]->X;
+            Y[c] += Nodes[i]->Y;
+            CellOf[Nodes[i]->Id] = c;
+        }
+        X[c] /= Start[c + 1] - Start[c];
+        Y[c] /= Start[c + 1] - Start[c];
+    }
+    /* The nearest centers of each center (by insertion) */
+    for (c = 0; c < K; c++) {
+        for (i = 0; i < NearCenters; i++)
+            Near[c * NearCenters + i] = -1;
+        for (e = 0; e < K; e++) {
+            if (e == c)
+                continue;
+            d = (X[c] - X[e]) * (X[c] - X[e]) + (Y[c] - Y[e]) * (Y[c] - Y[e]);
+            j = c * NearCenters;
+            i = NearCenters - 1;
+            if (Near[j + i] >= 0 && d >= NearD[j + i])
+                continue;
+            for (; i > 0 && (Near[j + i - 1] < 0 || d < NearD[j + i - 1]);
+                 i--) {
+                Near[j + i] = Near[j + i - 1];
+                NearD[j + i] = NearD[j + i - 1];
+            }
+            Near[j + i] = e;
+            NearD[j + i] = d;
+        }
+    }
+    for (Iteration = 0, Changes = 1; Iteration < 10 && Changes; Iteration++) {
+        for (c = 0; c < K; c++) {
+            SumX[c] = SumY[c] = 0;
+            Count[c] = 0;
+        }
+        for (i = Changes = 0; i < Dimension; i++) {
+            N = Nodes[i];
+            Best = c = CellOf[N->Id];
+            BestD = (N->X - X[c]) * (N->X - X[c]) +
+                (N->Y - Y[c]) * (N->Y - Y[c]);
+            for (j = 0; j < NearCenters; j++) {
+                if ((e = Near[c * NearCenters + j]) < 0)
+                    break;
+                d = (N->X - X[e]) * (N->X - X[e]) +
+                    (N->Y - Y[e]) * (N->Y - Y[e]);
+                if (d < BestD) {
+                    Best = e;
+                    BestD = d;
+                }
+            }
+            if (Best != c) {
+                CellOf[N->Id] = Best;
+                Changes++;
+            }
+            SumX[Best] += N->X;
+            SumY[Best] += N->Y;
+            Count[Best]++;
+        }
+        for (c = 0; c < K; c++) {
+            if (Count[c] == 0)
+                continue;
+            X[c] = SumX[c] / Count[c];
+            Y[c] = SumY[c] / Count[c];
+        }
+    }
+    /* Sort the nodes by cluster, and split the clusters that are too
+       large */
+    for (c = 0, i = 0; c < K; c++) {
+        e = Count[c];
+        Count[c] = i;
+        i += e;
+    }
+    for (i = 1; i <= Dimension; i++)
+        Nodes[Count[CellOf[i]]++] = &NodeSet[i];
+    Cells = 0;
+    for (c = 0, i = 0; c < K; c++) {
+        if (Count[c] > i)
+            Split(Nodes + i, Count[c] - i);
+        i = Count[c];
+    }
+    free(X);
+    free(Count);
+    free(Near);
+    free(NearD);
+}
+
+/*
+   The SolveCell function is called by a child process. It solves the
+   problem given by the nodes of a cell and writes their pi-values,
+   candidates and tour neighbors into shared memory.
+*/
+
+static void SolveCell(long Cell)
+{
+    FILE *Text;
+    char *Data = 0;
+    size_t Size;
+    Node **Set = Nodes + Start[Cell], *N;
+    Candidate *NN;
+    long Count = Start[Cell + 1] - Start[Cell], Candidates = MaxCandidates,
+        *Id, a, i, k;
+
+    if (!(Text = open_memstream(&Data, &Size)))
+        exit(1);
+    fprintf(Text, "NAME : CELL\nTYPE : TSP\nDIMENSION : %ld\n"
+            "EDGE_WEIGHT_TYPE : %s\nNODE_COORD_SECTION\n", Count,
+            EdgeWeightType);
+    for (i = 0; i < Count; i++)
+        fprintf(Text, "%ld %.17g %.17g\n", i + 1, Set[i]->X, Set[i]->Y);
+    fprintf(Text, "EOF\n");
+    fclose(Text);
+    /* The nodes of the problem are freed when the cell is read */
+    assert(Id = (long *) malloc(Count * sizeof(long)));
+    for (i = 0; i < Count; i++)
+        Id[i] = Set[i]->Id;
+    if (!SolveSubproblem(Data))
+        return;
+    for (i = 1; i <= Count; i++) {
+        N = &NodeSet[BestTour[i]];
+        a = Id[N->Id - 1];
+        Pi[a] = N->Pi;
+        for (k = 0, NN = N->CandidateSet; NN && NN->To && k < Candidates;
+             NN++, k++) {
+            Cand[a * Candidates + k] = Id[NN->To->Id - 1];
+            Alpha[a * Candidates + k] = NN->Alpha;
+        }
+        Adj[2 * a] = Id[BestTour[i == 1 ? Count : i - 1] - 1];
+        Adj[2 * a + 1] = Id[BestTour[i % Count + 1] - 1];
+    }
+}
+
+/*
+   The Stitch function joins the tours of the cells (given by Adj) into one
+   tour. Cell k is joined with cell k - 1 by removing an edge (a,a2) of the
+   tour of cell k - 1 and an edge (b,b2) of the tour of cell k, and adding
+   either (a,b) and (a2,b2), or (a,b2) and (a2,b), whichever is cheapest.
+   The edges of a tour of a cell are the edges (a,Adj[2 * a + 1]) between
+   nodes of the cell.
+*/
+
+static void Stitch()
+{
+    long k, i, j, a, a2, b, b2, Ba, Ba2, Bb, Bb2, Crossed;
+    long dA, dB, d, d1, d2;
+    long long Best, Delta;
+
+    for (k = 1; k < Cells; k++) {
+        Best = LLONG_MAX;
+        Ba = Ba2 = Bb = Bb2 = Crossed = 0;
+        for (i = Start[k - 1]; i < Start[k]; i++) {
+            a = Nodes[i]->Id;
+            if (CellOf[a2 = Adj[2 * a + 1]] != k - 1)
+                continue;
+            dA = Distance(&NodeSet[a], &NodeSet[a2]);
+            for (j = Start[k]; j < Start[k + 1]; j++) {
+                b = Nodes[j]->Id;
+                if (CellOf[b2 = Adj[2 * b + 1]] != k)
+                    continue;
+                dB = Distance(&NodeSet[b], &NodeSet[b2]);
+                d = Distance(&NodeSet[a], &NodeSet[b]);
+                if (d < NearestCost[a]) {
+                    NearestCost[a] = d;
+                    Nearest[a] = b;
+                }
+                if (d < NearestCost[b]) {
+                    NearestCost[b] = d;
+                    Nearest[b] = a;
+                }
+                d1 = d + Distance(&NodeSet[a2], &NodeSet[b2]);
+                d2 = Distance(&NodeSet[a], &NodeSet[b2]) +
+                    Distance(&NodeSet[a2], &NodeSet[b]);
+                Delta = (d1 < d2 ? d1 : d2) - dA - dB;
+                if (Delta < Best) {
+                    Best = Delta;
+                    Ba = a;
+                    Ba2 = a2;
+                    Bb = b;
+                    Bb2 = b2;
+                    Crossed = d2 < d1;
+                }
+            }
+        }
+        if (Best == LLONG_MAX)
+            eprintf("PARTITIONING: Cannot join cell %ld", k);
+        if (Crossed) {
+            b = Bb;
+            Bb = Bb2;
+            Bb2 = b;
+        }
+        Replace(Ba, Ba2, Bb);
+        Replace(Ba2, Ba, Bb2);
+        Replace(Bb, Bb2, Ba);
+        Replace(Bb2, Bb, Ba2);
+    }
+}
+
+/*
+   The Replace function replaces the tour neighbor Old of node a by New.
+*/
+
+static void Replace(long a, long Old, long New)
+{
+    if (Adj[2 * a] == Old)
+        Adj[2 * a] = New;
+    else
+        Adj[2 * a + 1] = New;
+}
+
+static void AddCell(long Count)
+{
+    if (Cells + 2 > CellSpace) {
+        CellSpace = 2 * CellSpace + 16;
+        assert(Start = (long *) realloc(Start, CellSpace * sizeof(long)));
+    }
+    if (Cells == 0)
+        Start[0] = 0;
+    Start[Cells + 1] = Start[Cells] + Count;
+    Cells++;
+}
+
+static int CompareX(const void *Na, const void *Nb)
+{
+    double a = (*(Node **) Na)->X, b = (*(Node **) Nb)->X;
+
+    return a < b ? -1 : a > b ? 1 : 0;
+}
+
+static int CompareY(const void *Na, const void *Nb)
+{
+    double a = (*(Node **) Na)->Y, b = (*(Node **) Nb)->Y;
+
+    return a < b ? -1 : a > b ? 1 : 0;
+}
@@ -0,0 +1,251 @@
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "INCLUDE/LK.h"
+
+/*
+   The SolveSubproblems function improves the best tour by tour segment
+   partitioning (SUBPROBLEM_SIZE = S). It is called by Solve after the last
+   run.
+
+   The tour is cut into segments of about S consecutive nodes. Each segment
+   is solved as a problem of its own (a subproblem): the nodes of the
+   segment, in which the edge between the two end nodes of the segment is
+   fixed. A tour of the subproblem is thus a path through the segment from
+   one end node to the other, closed by the fixed edge, and it may replace
+   the segment in the tour. The subproblem is given in TSPLIB format
+   (ProblemData). If the distances are given by a function of coordinates,
+   the coordinates of the nodes are given; otherwise the distance matrix of
+   the nodes is given. The segment itself is given as the initial tour
+   (TOUR_SECTION), and fixed edges of the segment remain fixed.
+
+   Since the end nodes of the segments stay in place, the subproblems are
+   independent. Each subproblem is solved by its own process (the state of
+   the solver is global), and as many processes as there are processors
+   run at a time. A process writes the new order of its segment into
+   shared memory. When all segments have been solved, the improved
+   segments are spliced into the tour.
+
+   This is repeated in rounds. In each round, the segment boundaries are
+   shifted by S/2, so that the nodes near the boundaries of one round are
+   inside a segment in the next. The rounds end when two rounds in a
+   row give no improvement, or when the deadline is reached.
+
+   If the tour has been improved, it becomes the current tour (and is
+   recorded by RecordBetterTour), and its cost is returned. Otherwise,
+   DBL_MAX is returned.
+*/
+
+static int *Tour = 0;           /* The tour, as a list of node numbers */
+static int *Order;              /* The new orders of the segments (shared) */
+
+static void SolveSegment(long First, long Length);
+static long long PathCost(int *Path, long Length);
+
+double SolveSubproblems()
+{
+    long Segments, Workers, Running, Round = 0, Fruitless = 0, Improved,
+        Offset, First, Last, Length, i, k;
+    long long Gain = 0, RoundGain, OldCost, NewCost;
+    pid_t Pid;
+    double StartTime = GetWallTime();
+
+    if (SubproblemSize <= 0)
+        return DBL_MAX;
+    if (ProblemType != TSP) {
+        printf("SUBPROBLEM_SIZE: Ignored (the problem is not a TSP)\n");
+        return DBL_MAX;
+    }
+    assert(Tour = (int *) realloc(Tour, Dimension * sizeof(int)));
+    if ((Order = (int *) mmap(0, Dimension * sizeof(int),
+                              PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_ANONYMOUS, -1,
+                              0)) == MAP_FAILED)
+        eprintf("SUBPROBLEM_SIZE: Cannot allocate shared memory");
+    for (i = 0; i < Dimension; i++)
+        Tour[i] = (int) BestTour[i + 1];
+    if ((Workers = sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+        Workers = 1;
+    Segments = Dimension / SubproblemSize;
+    if (Segments == 0)
+        Segments = 1;
+
+    do {
+        /* Rotate the tour, so that segment k starts at k * Dimension /
+           Segments */
+        Offset = Round > 0 ? SubproblemSize / 2 : 0;
+        for (i = 0; i < Dimension; i++)
+            Order[i] = Tour[(i + Offset) % Dimension];
+        memcpy(Tour, Order, Dimension * sizeof(int));
+        fflush(stdout);
+        for (k = Running = 0; k < Segments; k++) {
+            First = k * Dimension / Segments;
+            if ((Length = (k + 1) * Dimension / Segments - First) < 4)
+                continue;
+            if (Running == Workers && wait(0) > 0)
+                Running--;
+            if ((Pid = fork()) < 0)
+                eprintf("SUBPROBLEM_SIZE: Cannot create process");
+            if (Pid == 0) {
+                SolveSegment(First, Length);
+                exit(0);
+            }
+            Running++;
+        }
+        while (wait(0) > 0);
+
+        /* Splice the improved segments into the tour */
+        RoundGain = Improved = 0;
+        for (k = 0; k < Segments; k++) {
+            First = k * Dimension / Segments;
+            Length = (k + 1) * Dimension / Segments - First;
+            Last = First + Length - 1;
+            if (Order[First] != Tour[First] || Order[Last] != Tour[Last])
+                continue;
+            OldCost = PathCost(Tour + First, Length);
+            NewCost = PathCost(Order + First, Length);
+            if (NewCost >= OldCost)
+                continue;
+            memcpy(Tour + First, Order + First, Length * sizeof(int));
+            RoundGain += OldCost - NewCost;
+            Improved++;
+        }
+        Gain += RoundGain;
+        Fruitless = RoundGain > 0 ? 0 : Fruitless + 1;
+        Round++;
+        if (TraceLevel >= 1) {
+            printf("SUBPROBLEMS: Round %ld, Segments = %ld, Improved = %ld, "
+                   "Cost = %0.0f, Time = %0.3f sec.\n", Round, Segments,
+                   Improved, BestCost - (double) Gain / Precision,
+                   GetWallTime() - StartTime);
+            fflush(stdout);
+        }
+    } while (Fruitless < 2 && (EndTime == 0 || GetWallTime() < EndTime));
+    munmap(Order, Dimension * sizeof(int));
+    if (Gain == 0)
+        return DBL_MAX;
+    FirstNode = &NodeSet[Tour[0]];
+    for (i = 1; i < Dimension; i++)
+        Link(&NodeSet[Tour[i - 1]], &NodeSet[Tour[i]]);
+    Link(&NodeSet[Tour[Dimension - 1]], FirstNode);
+    RecordBetterTour();
+    return BestCost - (double) Gain / Precision;
+}
+
+/*
+   The SolveSegment function is called by a child process. It solves the
+   subproblem of the Length nodes Tour[First], ..., Tour[First + Length - 1]
+   and writes the new order of the nodes into Order[First], ...,
+   Order[First + Length - 1].
+*/
+
+static void SolveSegment(long First, long Length)
+{
+    FILE *Text;
+    char *Data = 0;
+    size_t Size;
+    int *Path = Tour + First;
+    long i, j, Dir;
+    Node *Na, *Nb;
+
+    if (!(Text = open_memstream(&Data, &Size)))
+        exit(1);
+    fprintf(Text, "NAME : SUBPROBLEM\nTYPE : TSP\nDIMENSION : %ld\n",
+            Length);
+    if (Distance != Distance_EXPLICIT && Distance != Distance_1 &&
+        Distance != Distance_ATSP) {
+        fprintf(Text, "EDGE_WEIGHT_TYPE : %s\nNODE_COORD_SECTION\n",
+                EdgeWeightType);
+        for (i = 0; i < Length; i++) {
+            Na = &NodeSet[Path[i]];
+            fprintf(Text, "%ld %.17g %.17g\n", i + 1, Na->X, Na->Y);
+        }
+    } else {
+        /* The distances, without the pi-values and the precision */
+        fprintf(Text, "EDGE_WEIGHT_TYPE : EXPLICIT\n"
+                "EDGE_WEIGHT_FORMAT : LOWER_DIAG_ROW\n"
+                "EDGE_WEIGHT_SECTION\n");
+        for (i = 0; i < Length; i++) {
+            Na = &NodeSet[Path[i]];
+            for (j = 0; j < i; j++) {
+                Nb = &NodeSet[Path[j]];
+                fprintf(Text, " %ld", (C(Na, Nb) - Na->Pi - Nb->Pi) /
+                        Precision);
+            }
+            fprintf(Text, " 0\n");
+        }
+    }
+    fprintf(Text, "FIXED_EDGES_SECTION\n1 %ld\n", Length);
+    for (i = 1; i < Length; i++)
+        if (Fixed(&NodeSet[Path[i - 1]], &NodeSet[Path[i]]))
+            fprintf(Text, "%ld %ld\n", i, i + 1);
+    fprintf(Text, "-1\nTOUR_SECTION\n");
+    for (i = 1; i <= Length; i++)
+        fprintf(Text, "%ld\n", i);
+    fprintf(Text, "-1\nEOF\n");
+    fclose(Text);
+
+    if (!SolveSubproblem(Data))
+        return;
+
+    /* The path from node 1 to node Length (the end nodes) */
+    for (i = 1; BestTour[i] != 1; i++);
+    Dir = BestTour[i % Length + 1] == Length ? -1 : 1;
+    for (j = 0; j < Length; j++, i = (i - 1 + Dir + Length) % Length + 1)
+        Order[First + j] = Path[BestTour[i] - 1];
+}
+
+/*
+   The SolveSubproblem function is called by a child process. It solves the
+   problem given in TSPLIB format by Data with the parameters of the
+   parameter file, but with only one run, without input and output files,
+   and without output. The process no longer shares the incumbent of a
+   portfolio (see Portfolio), and errors terminate it. The function returns
+   0 if the deadline has been reached; otherwise 1.
+*/
+
+int SolveSubproblem(char *Data)
+{
+    ResetParameters();
+    free(ProblemFileName);
+    assert(ProblemFileName = (char *) malloc(2));
+    strcpy(ProblemFileName, "-");
+    ProblemData = Data;
+    PiFileName = TourFileName = CandidateFileName = InitialTourFileName =
+        InputTourFileName = CheckpointFileName = 0;
+    MergeTourFileName[0] = MergeTourFileName[1] = 0;
+    SubproblemSize = 0;
+    Partitioning = NO_PARTITIONING;
+    SweepCandidates = 0;
+    BackboneFraction = 0;
+    Runs = 1;
+    TraceLevel = 0;
+    if (EndTime > 0 && (Deadline = EndTime - GetWallTime()) <= 0)
+        return 0;
+    ErrorReturn = 0;
+    TourCallback = 0;
+    DetachIncumbent();
+    if (!freopen("/dev/null", "w", stdout))
+        exit(1);
+    Solve(0, 0);
+    return 1;
+}
+
+/*
+   The PathCost function returns the cost of the path through the Length
+   nodes of Path (multiplied by the precision).
+*/
+
+static long long PathCost(int *Path, long Length)
+{
+    long long Cost = 0;
+    Node *Na, *Nb;
+    long i;
+
+    for (i = 1; i < Length; i++) {
+        Na = &NodeSet[Path[i - 1]];
+        Nb = &NodeSet[Path[i]];
+        Cost += C(Na, Nb) - Na->Pi - Nb->Pi;
+    }
+    return Cost;
+}
@@ -10,7 +10,12 @@
    It sets OldPred to Pred and OldSuc to Suc for each of these nodes. In this
    way it can always be determined whether an edge belongs to current starting
    tour. This is used by the BestMove function to determine whether an edge is
-   excludable.
+   excludable. The nodes are also "touched" (see the Touch function).
+   When SW_THREADS > 1, the moves are first recorded for replay by the
+   worker threads of SwNeighborhoodParallel (see RecordSwaps). When
+   KICK_TYPE is SEGMENT_DOUBLE_BRIDGE, the moves are also appended to the
+   trial log, so that they can be undone when the best tour is restored
+   (see LogSwaps).
 
    Finally, for each of these nodes the function updates their Cost field.
    The Cost field contains for each node its minimum cost of candidate edges 
@@ -24,6 +29,9 @@ void StoreTour(int activate)
     Candidate *Nt;
     int i;
 
+    if (SW && SwThreads > 1 && SwStrategy == BREADTH && !WorkerThread)
+        RecordSwaps();
+    LogSwaps();
     while (Swaps > 0) {
         Swaps--;
         for (i = 1; i <= 4; i++) {
@@ -32,6 +40,8 @@ void StoreTour(int activate)
                 i == 3 ? SwapStack[Swaps].t3 : SwapStack[Swaps].t4;
             if (activate == 1)
                 Activate(t);
+            if (!WorkerThread)
+                Touch(t);
             t->OldPred = t->Pred;
             t->OldSuc = t->Suc;
             t->OldPredExcluded = t->OldSucExcluded = 0;
@@ -0,0 +1,107 @@
+#include "INCLUDE/Segment.h"
+#include "INCLUDE/LK.h"
+
+/*
+   The SwNeighborhoodBeam function is an alternative to the
+   SwNeighborhoodBreadth function. It is used by the LinKernighanSW function
+   when SW_STRATEGY = BEAM.
+
+   Starting from the root move, Root, the move tree is explored level by
+   level, as in SwNeighborhoodBreadth. The candidates of each node are
+   sampled in the same way, and the moves are evaluated on a virtual tour
+   (see VirtualSwaps). However, only the BeamWidth nodes with the
+   largest G2Gain values of each level are kept for expansion at the next
+   level. The nodes are taken from a pool of MaxDepth * BeamWidth nodes
+   allocated at the first call. Thus, the space used is O(BeamWidth * MaxDepth),
+   instead of O(Lambda^MaxDepth) for the full move tree. This makes deep
+   searches affordable.
+
+   As soon as a move with positive gain is found, the search stops. In this
+   case, all but the last 2-opt move of the move are made on the tour, and
+   the move is returned (the caller makes the last one). Otherwise, the tour
+   is left unchanged, and the move with the largest gain found is returned.
+   Root->NumChildren is set to the number of moves found at the first level.
+*/
+
+static SwapMove *Pool = 0;      /* MaxDepth levels of BeamWidth nodes */
+static int PoolSpace = 0;       /* The capacity of Pool */
+static SwapMove Found;          /* The move returned */
+
+SwapMove *SwNeighborhoodBeam(SwapMove * Root)
+{
+    Node *t1, *t2, *t3, *t4;
+    Candidate *Nt2;
+    SwapMove *Move, *Level, *Next, *Worst;
+    long G1, G2, MoveGain, BestGain = LONG_MIN;
+    int Depth, Size = 1, NextSize, Count, lambdaCandidates, i, j, l;
+    int Index, Forward;
+    CandidateSampler Sampler;
+
+    if (MaxDepth * BeamWidth > PoolSpace) {
+        free(Pool);
+        PoolSpace = MaxDepth * BeamWidth;
+        assert(Pool = (SwapMove *) calloc(PoolSpace, sizeof(SwapMove)));
+    }
+    Root->NumChildren = 0;
+    Level = Root;
+    for (Depth = 0; Depth < MaxDepth && Size > 0; Depth++) {
+        Next = Pool + Depth * BeamWidth;
+        NextSize = 0;
+        for (j = 0; j < Size; j++) {
+            Move = &Level[j];
+            VirtualSwaps(Move);
+            t1 = Move->t1;
+            t2 = Move == Root ? Move->t2 : Move->t4;
+            Forward = VirtualSUC(t1) == t2;
+            Count = 0;
+            for (Nt2 = t2->CandidateSet; Nt2->To; Nt2++)
+                Count++;
+            lambdaCandidates = Count < Lambda ? Count : Lambda;
+            StartSampler(&Sampler, Count);
+            for (l = 0; l < lambdaCandidates; l++) {
+                if ((Index = NextSample(&Sampler)) < 0)
+                    break;
+                Nt2 = &t2->CandidateSet[Index];
+                t3 = Nt2->To;
+                if (t3 == VirtualPRED(t2) || t3 == VirtualSUC(t2) ||
+                    ((G1 = Move->G2Gain - Nt2->Cost) <= 0 &&
+                     GainCriterionUsed && ProblemType != HCP &&
+                     ProblemType != HPP))
+                    continue;
+                t4 = Forward ? VirtualPRED(t3) : VirtualSUC(t3);
+                G2 = G1 + C(t3, t4);
+                MoveGain = G2 - C(t4, t1);
+                coNodes++;
+                if (Move == Root)
+                    Root->NumChildren++;
+                if (MoveGain > BestGain) {
+                    BestGain = MoveGain;
+                    Found.parent = Move;
+                    BestSwapTree = &Found;
+                    SetSwapMove(&BestSwapTree, t1, t2, t3, t4,
+                                MoveGain, G2);
+                    if (MoveGain > 0) {
+                        ReInitSwaps(Move);
+                        return BestSwapTree;
+                    }
+                }
+                /* Keep the BeamWidth moves with the largest G2Gain */
+                if (NextSize < BeamWidth)
+                    Worst = &Next[NextSize++];
+                else {
+                    Worst = Next;
+                    for (i = 1; i < BeamWidth; i++)
+                        if (Next[i].G2Gain < Worst->G2Gain)
+                            Worst = &Next[i];
+                    if (G2 <= Worst->G2Gain)
+                        continue;
+                }
+                Worst->parent = Move;
+                SetSwapMove(&Worst, t1, t2, t3, t4, MoveGain, G2);
+            }
+        }
+        Level = Next;
+        Size = NextSize;
+    }
+    return BestSwapTree;
+}
@@ -9,7 +9,8 @@ SwapMove *SwNeighborhoodBreadth(SwapMove *currentMove) {
     Candidate *Nt2;
     SwapMove *newSwapMove;
     long G1, G2, moveGain = LONG_MIN;
-    int randomIndex, reelRandomIndex, lambdaCandidates;
+    int reelRandomIndex, lambdaCandidates, forward;
+    CandidateSampler sampler;
 
     // Variables de la file
     int rear = 0, front = 0;
@@ -19,21 +20,18 @@ SwapMove *SwNeighborhoodBreadth(SwapMove *currentMove) {
 
     Queue[rear++] = currentMove;
 
-    while (rear != front) {
+    while (rear != front && !ExitSwNeighborhood) {
         currentMove = Queue[front++];
 
-        if (SUC(currentMove->t1) != currentMove->t2)
-            Reversed ^= 1;
+        // Make the moves on the path from the root on a virtual tour
+        VirtualSwaps(currentMove);
 
         // if not root
         if (currentMove->parent != NULL) {
-            RestoreTour();
-            ReInitSwaps(currentMove);
             t1 = currentMove->t1;
             t2 = currentMove->t4;
-            if (SUC(t1) != t2)
-                Reversed ^= 1;
         }
+        forward = VirtualSUC(t1) == t2;
 
         lambdaCandidates = Lambda;
         int Count = 0;
@@ -44,43 +42,27 @@ SwapMove *SwNeighborhoodBreadth(SwapMove *currentMove) {
         if (Count < Lambda)
             lambdaCandidates = Count;
 
-        int PossibleIndexes[Count];
-        for (int i = 0; i < Count; i++)
-            PossibleIndexes[i] = i;
+        StartSampler(&sampler, Count);
 
         int l = 0;
         while (l < lambdaCandidates) {
             // Sampling bias : Giving higher sampling probability to candidates order
-            if (!SamplingBiasUsed)
-                reelRandomIndex = l;
-            else {
-                if (SamplingBiasUsed == 2)
-                    randomIndex = (int) trunc(-log((double) GenerateRandomNonZero()) / log(2));
-                else if (SamplingBiasUsed == 1)
-                    randomIndex = (int) Random() % Count;
-
-                if (randomIndex > Count - l - 1)
-                    randomIndex = Count - l - 1;
-
-                reelRandomIndex = PossibleIndexes[randomIndex];
-            }
+            if ((reelRandomIndex = NextSample(&sampler)) < 0)
+                break;
 
             /* Choose (t2,t3) as a candidate edge emanating from t2 */
             Nt2 = &(t2->CandidateSet[reelRandomIndex]);
             t3 = Nt2->To;
 
             // if the Candidat is not feasible
-            if (t3 == t2->Pred || t3 == t2->Suc ||
+            if (t3 == VirtualPRED(t2) || t3 == VirtualSUC(t2) ||
                 ((G1 = currentMove->G2Gain - Nt2->Cost) <= 0 && GainCriterionUsed && ProblemType != HCP &&
                  ProblemType != HPP)) {
-                if (SamplingBiasUsed != 0){
-                    ShiftToEnd(PossibleIndexes, Count, randomIndex);
-                }
                 l++;
                 continue;
             } else {
                 // Choose t4 (only one choice gives a closed tour)
-                t4 = PRED(t3);
+                t4 = forward ? VirtualPRED(t3) : VirtualSUC(t3);
                 // Feasible move !
                 G2 = G1 + C(t3, t4);
                 moveGain = G2 - C(t4, t1);
@@ -113,15 +95,13 @@ SwapMove *SwNeighborhoodBreadth(SwapMove *currentMove) {
                 // Record the best tree node or return it if the gain is positive
                 if (moveGain > 0) {
                     BestSwapTree = newSwapMove;
+                    ReInitSwaps(currentMove);
                     return BestSwapTree;
                 } else {
                     if (moveGain > BestSwapTree->Gain)
                         BestSwapTree = newSwapMove;
                 }
             }
-            if (SamplingBiasUsed != 0){
-                ShiftToEnd(PossibleIndexes, Count, randomIndex);
-            }
             l++;
         }
     }
@@ -139,3 +119,18 @@ void ReInitSwaps(SwapMove *swapMove) {
 }
 
 
+/*
+   The VirtualSwaps function makes the 2-opt moves on the path from the
+   root to swapMove on a virtual tour (see VirtualTour.c). The current tour
+   is not changed.
+*/
+
+void VirtualSwaps(SwapMove *swapMove) {
+    int pathLength;
+    SwapMove **pathToRoot = FindPathToRoot(swapMove, &pathLength);
+    ResetVirtualTour(swapMove->t1);
+    for (int i = pathLength - 2; i >= 0; i--)
+        VirtualFlip(pathToRoot[i]->t1, pathToRoot[i]->t2,
+                    pathToRoot[i]->t3, pathToRoot[i]->t4);
+    free(pathToRoot);
+}
@@ -0,0 +1,400 @@
+#include <pthread.h>
+#include <unistd.h>
+#include "INCLUDE/Segment.h"
+#include "INCLUDE/LK.h"
+
+/*
+   The SwNeighborhoodParallel function is a multi-threaded version of the
+   SwNeighborhoodBreadth function. It is used instead of SwNeighborhoodBreadth
+   by the LinKernighanSW function when SW_THREADS > 1.
+
+   First, the root of the move tree, Root, is expanded by the calling (master)
+   thread, exactly as SwNeighborhoodBreadth would do it. If this gives a
+   move with positive gain, the move is returned at once. Otherwise, each of
+   the top-level moves (the children of the root) is explored by one of
+   SwThreads worker threads. A worker explores its branch breadth-first with
+   SwNeighborhoodBreadth, on a private copy of the tour, using a private move
+   tree and queue. The first worker that finds a move with positive gain
+   sets ExitSwNeighborhood, which makes the other workers stop early.
+
+   The best move over all branches is chosen by the same rule as in
+   SwNeighborhoodBreadth: a move with positive gain is preferred (the one of
+   the lowest numbered branch, if more than one is found); otherwise, the
+   move with the largest gain is chosen. As with SwNeighborhoodBreadth, if
+   the chosen move has positive gain, all but its last 2-opt move are made
+   on the tour on return, and the caller makes the last one.
+
+   The worker copies of the tour are kept up to date by means of a log of
+   all 2-opt moves committed by the master since the last exploration (see
+   RecordSwaps). Each worker replays the log before it starts on a branch.
+
+   The worker threads and their copies are kept from trial to trial. The
+   StartSwWorkers function is called at the start of each trial of
+   LinKernighanSW. It creates the workers, unless they exist already for
+   the current problem size and parameters, and lets the workers bring
+   their copies up to date: after replaying the log, a worker copies the
+   nodes the master has changed between the trials (see UpdateClone). Only
+   when the master has marked all nodes as changed is the copy made anew
+   by CloneNodes.
+*/
+
+typedef struct SwWorker {
+    pthread_t Thread;
+    Node *NodeSet;              /* The worker's copy of the nodes */
+    Candidate *CandidateSet;    /* The worker's copy of the candidate sets */
+    long CandidateSpace;        /* The capacity of CandidateSet */
+    SwapRecord *SwapStack;      /* The worker's stack of swaps */
+    SwapMove *Tree;             /* The worker's move tree */
+    SwapMove **Queue;           /* The worker's queue of tree nodes */
+    SwapMove Sentinel;          /* The initial best move of the worker */
+    unsigned Seed;              /* The seed of the worker's random sequence */
+    int Stream;                 /* The number of the worker's subsequence */
+} SwWorker;
+
+typedef struct Branch {
+    long t[4];                  /* The Ids of the nodes of the top-level move */
+    long Gain, G2Gain;          /* Gain and G2Gain of the top-level move */
+    long BestGain;              /* The gain of the best move in the branch */
+    long Best[4];               /* The Ids of the nodes of the best move */
+    long *Swaps;                /* The swaps (Ids) of the best move, if its
+                                   gain is positive */
+    long SwapCount;             /* The number of swaps in Swaps */
+} Branch;
+
+static SwWorker *Workers = 0;
+static SwapMove *TopTree = 0;
+static SwapMove **TopQueue = 0;  /* The master's queue of TopTree nodes */
+static Branch *Branches = 0;
+static long BranchCount, NextBranch, RootId[2], RootG2Gain;
+static long *Log = 0, LogCount, LogSpace;
+static long *LogMoves = 0;      /* The number of swaps of each logged move */
+static long LogMoveCount, LogMoveSpace;
+static int Quit;                /* 1, if the workers are to terminate */
+static int Sync;                /* 1, if the copies are to be updated */
+static int FullSync;            /* 1, if the copies are to be made anew */
+static long WorkerEpoch;        /* The epoch in which the copies were last
+                                   updated (see CloneIsCurrent) */
+static long WorkerDimension;    /* The Dimension for which Workers is allocated */
+static int WorkerCount, WorkerLambda, WorkerDepth;
+static pid_t WorkerPid;         /* The process that created the workers */
+static pthread_mutex_t BranchMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_barrier_t Barrier;
+static SwapMove Result;
+
+static void *RunSwWorker(void *Arg);
+static void ExploreBranch(SwWorker * W, Branch * B);
+static void CreateSwWorkers();
+static void StopSwWorkers();
+
+SwapMove *SwNeighborhoodParallel(SwapMove * Root)
+{
+    SwapMove *Best, *Child, **SavedQueue;
+    Branch *B, *BestBranch = 0;
+    long k;
+
+    if (!Workers)
+        /* MaxDepth is 0; the move tree has no branches to explore */
+        return SwNeighborhoodBreadth(Root);
+
+    /* Expand the root */
+    ResetIsActive(&TopTree);
+    TopTree->t1 = Root->t1;
+    TopTree->t2 = Root->t2;
+    TopTree->G2Gain = Root->G2Gain;
+    TopTree->IsActive = 1;
+    SavedQueue = Queue;
+    Queue = TopQueue;
+    Best = SwNeighborhoodBreadth(TopTree);
+    Queue = SavedQueue;
+    Root->NumChildren = TopTree->NumChildren;
+    if (Best->Gain > 0 || TopTree->NumChildren == 0)
+        return Best;
+
+    /* Explore the branches in parallel */
+    BranchCount = NextBranch = 0;
+    RootId[0] = Root->t1->Id;
+    RootId[1] = Root->t2->Id;
+    RootG2Gain = Root->G2Gain;
+    for (Child = TopTree->firstChild; Child && Child->IsActive;
+         Child = Child->nextSibling) {
+        B = &Branches[BranchCount++];
+        B->t[0] = Child->t1->Id;
+        B->t[1] = Child->t2->Id;
+        B->t[2] = Child->t3->Id;
+        B->t[3] = Child->t4->Id;
+        B->Gain = Child->Gain;
+        B->G2Gain = Child->G2Gain;
+    }
+    ExitSwNeighborhood = 0;
+    pthread_barrier_wait(&Barrier);
+    /* The workers replay the log and explore the branches */
+    pthread_barrier_wait(&Barrier);
+    ExitSwNeighborhood = 0;
+    LogCount = LogMoveCount = 0;
+
+    /* Choose the best move */
+    for (B = Branches; B < Branches + BranchCount; B++) {
+        if (B->BestGain > 0) {
+            BestBranch = B;
+            break;
+        }
+        if (B->BestGain > Best->Gain &&
+            (!BestBranch || B->BestGain > BestBranch->BestGain))
+            BestBranch = B;
+    }
+    if (!BestBranch)
+        return Best;
+    Result = *Best;
+    Result.Gain = BestBranch->BestGain;
+    Result.t1 = &NodeSet[BestBranch->Best[0]];
+    Result.t2 = &NodeSet[BestBranch->Best[1]];
+    Result.t3 = &NodeSet[BestBranch->Best[2]];
+    Result.t4 = &NodeSet[BestBranch->Best[3]];
+    if (Result.Gain > 0)
+        for (k = 0; k < BestBranch->SwapCount - 1; k++)
+            Swap1(&NodeSet[BestBranch->Swaps[3 * k]],
+                  &NodeSet[BestBranch->Swaps[3 * k + 1]],
+                  &NodeSet[BestBranch->Swaps[3 * k + 2]]);
+    return BestSwapTree = &Result;
+}
+
+/*
+   The RecordSwaps function appends the 2-opt moves on SwapStack to the log
+   of moves to be replayed by the worker threads. It is called from the
+   StoreTour function, before the moves are committed. The workers replay
+   the moves of each call of StoreTour before they call StoreTour, as the
+   master does, so that their copies stay exact copies.
+*/
+
+void RecordSwaps()
+{
+    long i;
+
+    if (!Workers || SwThreads <= 1 || SwStrategy != BREADTH)
+        return;
+    if (3 * (LogCount + Swaps) > LogSpace) {
+        LogSpace = 2 * 3 * (LogCount + Swaps);
+        assert(Log = (long *) realloc(Log, LogSpace * sizeof(long)));
+    }
+    for (i = 0; i < Swaps; i++, LogCount++) {
+        Log[3 * LogCount] = SwapStack[i].t1->Id;
+        Log[3 * LogCount + 1] = SwapStack[i].t2->Id;
+        Log[3 * LogCount + 2] = SwapStack[i].t3->Id;
+    }
+    if (LogMoveCount == LogMoveSpace) {
+        LogMoveSpace = LogMoveSpace ? 2 * LogMoveSpace : 64;
+        assert(LogMoves =
+               (long *) realloc(LogMoves, LogMoveSpace * sizeof(long)));
+    }
+    LogMoves[LogMoveCount++] = Swaps;
+}
+
+/*
+   The StartSwWorkers function is called at the start of each trial of
+   LinKernighanSW (see above). If MAX_DEPTH is 0, the move tree is only a
+   root, so no workers are created, and SwNeighborhoodParallel searches
+   as SwNeighborhoodBreadth.
+*/
+
+void StartSwWorkers()
+{
+    if (Workers && WorkerPid != getpid())
+        /* Inherited from the parent process; the threads do not exist */
+        Workers = 0;
+    if (Workers &&
+        (WorkerDimension != Dimension || WorkerCount != SwThreads ||
+         WorkerLambda != Lambda || WorkerDepth != MaxDepth))
+        StopSwWorkers();
+    if (MaxDepth == 0)
+        return;
+    if (!Workers)
+        CreateSwWorkers();
+    /* Let the workers bring their copies up to date */
+    Sync = 1;
+    FullSync = !CloneIsCurrent(WorkerEpoch);
+    BranchCount = NextBranch = 0;
+    pthread_barrier_wait(&Barrier);
+    pthread_barrier_wait(&Barrier);
+    WorkerEpoch = ClearChanged();
+    Sync = 0;
+    LogCount = LogMoveCount = 0;
+}
+
+/*
+   The CreateSwWorkers function creates the workers, their move trees, and
+   the worker threads.
+*/
+
+static void CreateSwWorkers()
+{
+    unsigned StreamSeed;
+    int i;
+
+    WorkerDimension = Dimension;
+    WorkerCount = SwThreads;
+    WorkerLambda = Lambda;
+    WorkerDepth = MaxDepth;
+    WorkerPid = getpid();
+    WorkerEpoch = 0;
+    assert(Workers = (SwWorker *) calloc(SwThreads, sizeof(SwWorker)));
+    for (i = 0; i < SwThreads; i++) {
+        assert(Workers[i].SwapStack =
+               (SwapRecord *) malloc((Dimension + 10) *
+                                     sizeof(SwapRecord)));
+        Workers[i].Tree = CreateSwapMoveTree(MaxDepth + 1, Lambda, 0);
+        assert(Workers[i].Queue =
+               (SwapMove **) malloc(sizeof(SwapMove *) *
+                                    CountSwapMoveTreeNodes(Workers[i].
+                                                           Tree)));
+    }
+    TopTree = CreateSwapMoveTree(2, Lambda, 0);
+    /* The shared Queue is sized for SwapTree, which may be smaller */
+    assert(TopQueue =
+           (SwapMove **) malloc(sizeof(SwapMove *) *
+                                CountSwapMoveTreeNodes(TopTree)));
+    assert(Branches = (Branch *) calloc(Lambda, sizeof(Branch)));
+    for (i = 0; i < Lambda; i++)
+        assert(Branches[i].Swaps =
+               (long *) malloc(3 * (MaxDepth + 1) * sizeof(long)));
+    LogCount = LogMoveCount = 0;
+    Quit = 0;
+    pthread_barrier_init(&Barrier, 0, SwThreads + 1);
+    StreamSeed = Random();
+    for (i = 0; i < SwThreads; i++) {
+        Workers[i].Seed = StreamSeed;
+        Workers[i].Stream = i + 1;
+        if (pthread_create(&Workers[i].Thread, 0, RunSwWorker, &Workers[i]))
+            eprintf("SwNeighborhoodParallel: Cannot create thread");
+    }
+}
+
+/*
+   The RunSwWorker function is executed by each worker thread.
+*/
+
+static void *RunSwWorker(void *Arg)
+{
+    SwWorker *W = (SwWorker *) Arg;
+    Branch *B;
+    long i, k, Last;
+
+    WorkerThread = 1;
+    Reversed = 0;
+    SwapStack = W->SwapStack;
+    Swaps = 0;
+    Queue = W->Queue;
+    SRandom(W->Seed);
+    for (i = 0; i < W->Stream; i++)
+        RandomJump();
+    for (;;) {
+        pthread_barrier_wait(&Barrier);
+        if (Quit)
+            break;
+        if (Sync && FullSync)
+            CloneNodes(&W->NodeSet, &W->CandidateSet, &W->CandidateSpace);
+        else {
+            /* Replay the moves committed since the last exploration */
+            for (i = k = 0; i < LogMoveCount; i++) {
+                for (Last = k + LogMoves[i]; k < Last; k++)
+                    Swap1(&W->NodeSet[Log[3 * k]],
+                          &W->NodeSet[Log[3 * k + 1]],
+                          &W->NodeSet[Log[3 * k + 2]]);
+                StoreTour(0);
+            }
+            if (Sync)
+                UpdateClone(W->NodeSet);
+        }
+        for (;;) {
+            pthread_mutex_lock(&BranchMutex);
+            B = NextBranch < BranchCount ? &Branches[NextBranch++] : 0;
+            pthread_mutex_unlock(&BranchMutex);
+            if (!B)
+                break;
+            ExploreBranch(W, B);
+        }
+        pthread_barrier_wait(&Barrier);
+    }
+    return 0;
+}
+
+/*
+   The ExploreBranch function explores the branch B of the move tree on the
+   worker's copy of the tour. The root of the worker's tree is given the
+   root move, and its first child is given the top-level move of the branch.
+   SwNeighborhoodBreadth is then started at this child.
+*/
+
+static void ExploreBranch(SwWorker * W, Branch * B)
+{
+    Node *N = W->NodeSet;
+    SwapMove *Root = W->Tree, *Child = Root->firstChild, *Best, **Path;
+    int PathLength, i;
+
+    B->BestGain = LONG_MIN;
+    B->SwapCount = 0;
+    if (ExitSwNeighborhood)
+        return;
+    ResetIsActive(&W->Tree);
+    Root->t1 = &N[RootId[0]];
+    Root->t2 = &N[RootId[1]];
+    Root->G2Gain = RootG2Gain;
+    Root->IsActive = 1;
+    Root->NumChildren = 1;
+    SetSwapMove(&Child, &N[B->t[0]], &N[B->t[1]], &N[B->t[2]],
+                &N[B->t[3]], B->Gain, B->G2Gain);
+    W->Sentinel.Gain = LONG_MIN;
+    BestSwapTree = &W->Sentinel;
+    Best = SwNeighborhoodBreadth(Child);
+    if (Best == &W->Sentinel)
+        return;
+    B->BestGain = Best->Gain;
+    B->Best[0] = Best->t1->Id;
+    B->Best[1] = Best->t2->Id;
+    B->Best[2] = Best->t3->Id;
+    B->Best[3] = Best->t4->Id;
+    if (Best->Gain <= 0)
+        return;
+    ExitSwNeighborhood = 1;
+    /* Record the path of 2-opt moves from the branch to the best move */
+    Path = FindPathToRoot(Best, &PathLength);
+    for (i = PathLength - 2; i >= 0; i--, B->SwapCount++) {
+        B->Swaps[3 * B->SwapCount] = Path[i]->t1->Id;
+        B->Swaps[3 * B->SwapCount + 1] = Path[i]->t2->Id;
+        B->Swaps[3 * B->SwapCount + 2] = Path[i]->t3->Id;
+    }
+    free(Path);
+    RestoreTour();
+}
+
+/*
+   The StopSwWorkers function terminates the worker threads and frees the
+   workers, their copies of the nodes, and the move trees. It is called
+   when the workers were created for another problem (or other values of
+   SW_THREADS, LAMBDA or MAX_DEPTH).
+*/
+
+static void StopSwWorkers()
+{
+    int i;
+
+    Quit = 1;
+    pthread_barrier_wait(&Barrier);
+    for (i = 0; i < WorkerCount; i++) {
+        pthread_join(Workers[i].Thread, 0);
+        free(Workers[i].NodeSet);
+        free(Workers[i].CandidateSet);
+        free(Workers[i].SwapStack);
+        FreeSwapMove(&Workers[i].Tree);
+        free(Workers[i].Queue);
+    }
+    pthread_barrier_destroy(&Barrier);
+    free(Workers);
+    Workers = 0;
+    FreeSwapMove(&TopTree);
+    free(TopQueue);
+    TopQueue = 0;
+    for (i = 0; i < WorkerLambda; i++)
+        free(Branches[i].Swaps);
+    free(Branches);
+    Branches = 0;
+}
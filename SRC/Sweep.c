@@ -0,0 +1,226 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file implement the parameter sweep mode
+   (SWEEP_FILE). In this mode, the problem of the parameter file is solved
+   once for each of a list of configurations of the search parameters.
+
+   Each line of the sweep file gives parameter settings separated by
+   semicolons. A setting may list several values separated by commas. The
+   line then stands for all combinations of the values (a grid). For
+   example, the line
+       LAMBDA = 2, 3 ; MAX_CANDIDATES = 5, 8
+   gives four configurations. Empty lines and lines starting with # are
+   ignored. The settings of the parameter file apply to all configurations.
+
+   The preprocessing is done only once. The problem text is read into
+   memory (ProblemData), so that the state after the preprocessing is
+   reused (see PreprocessingCache). The candidate sets are computed for the
+   largest MAX_CANDIDATES of all configurations (SweepCandidates). Each
+   configuration then uses the first MAX_CANDIDATES candidates of each
+   node, that is, those with the smallest alpha-values (see
+   TruncateCandidateSets). Configurations that change other parameters of
+   the preprocessing (for example, EXCESS) repeat the preprocessing.
+
+   The ReadSweepConfiguration function sets the parameters for the next
+   configuration. It stores its label in *Label: the settings separated by
+   commas, without spaces (for example, "LAMBDA=2,MAX_CANDIDATES=8"). It
+   returns 0 if there are no more configurations.
+
+   The ReadConfigurations, ApplyConfiguration and ReadProblemData functions
+   are also used by the auto-tune mode (see AutoTune).
+*/
+
+static char **Configurations = 0;       /* The settings of each
+                                           configuration */
+static long ConfigurationCount = 0, ConfigurationSpace = 0, Next = 0;
+static char **Keys = 0, **Values = 0;   /* The fields of a line */
+static int Fields, FieldSpace = 0;
+static char *Scratch = 0, *LabelBuffer = 0;
+static size_t ScratchSpace = 0;
+
+static void Expand(int i, char *Prefix);
+static char *Trim(char *S);
+
+int ReadSweepConfiguration(char **Label)
+{
+    long i;
+
+    if (!Configurations) {
+        ResetParameters();
+        ReadProblemData();
+        ReadConfigurations(SweepFileName, &ConfigurationCount);
+        for (i = 0; i < ConfigurationCount; i++) {
+            ApplyConfiguration(Configurations[i]);
+            if (MaxCandidates > SweepCandidates)
+                SweepCandidates = MaxCandidates;
+        }
+    }
+    if (Next == ConfigurationCount)
+        return 0;
+    *Label = ApplyConfiguration(Configurations[Next++]);
+    return 1;
+}
+
+/*
+   The TruncateCandidateSets function reduces the candidate set of each
+   node to its first MaxCandidates candidates.
+*/
+
+void TruncateCandidateSets(long MaxCandidates)
+{
+    Node *N = FirstNode;
+    long Count;
+
+    do {
+        if (!N->CandidateSet)
+            continue;
+        for (Count = 0; Count < MaxCandidates &&
+             N->CandidateSet[Count].To; Count++);
+        N->CandidateSet[Count].To = 0;
+    } while ((N = N->Suc) != FirstNode);
+}
+
+/*
+   The ReadConfigurations function reads the configurations of a file in
+   the format described above. It returns the configurations, each as its
+   settings separated by semicolons, and stores their number in *Count.
+*/
+
+char **ReadConfigurations(char *FileName, long *Count)
+{
+    FILE *File;
+    char *Line, *Field, *Rest, *Value;
+
+    if (!(File = fopen(FileName, "r")))
+        eprintf("Cannot open %s", FileName);
+    while ((Line = ReadLine(File))) {
+        Line = Trim(Line);
+        if (*Line == '\0' || *Line == '#')
+            continue;
+        for (Fields = 0, Field = Line; Field; Field = Rest) {
+            if ((Rest = strchr(Field, ';')))
+                *Rest++ = '\0';
+            if (!(Value = strchr(Field, '=')))
+                eprintf("%s: <KEY> = <VALUES> expected: %s", FileName,
+                        Field);
+            *Value++ = '\0';
+            if (Fields == FieldSpace) {
+                FieldSpace = 2 * FieldSpace + 8;
+                assert(Keys = (char **)
+                       realloc(Keys, FieldSpace * sizeof(char *)));
+                assert(Values = (char **)
+                       realloc(Values, FieldSpace * sizeof(char *)));
+            }
+            Keys[Fields] = Trim(Field);
+            Values[Fields++] = Value;
+        }
+        Expand(0, "");
+    }
+    fclose(File);
+    if (ConfigurationCount == 0)
+        eprintf("No configurations in %s", FileName);
+    *Count = ConfigurationCount;
+    return Configurations;
+}
+
+/*
+   The ReadProblemData function reads the problem file into memory.
+*/
+
+void ReadProblemData()
+{
+    FILE *File;
+    long Size;
+
+    if (!(File = fopen(ProblemFileName, "rb")) ||
+        fseek(File, 0, SEEK_END) || (Size = ftell(File)) < 0)
+        eprintf("Cannot open %s", ProblemFileName);
+    rewind(File);
+    assert(ProblemData = (char *) malloc(Size + 1));
+    if (fread(ProblemData, 1, Size, File) != (size_t) Size)
+        eprintf("Cannot read %s", ProblemFileName);
+    ProblemData[Size] = '\0';
+    fclose(File);
+}
+
+/*
+   The Expand function adds the configurations given by the fields i,
+   i + 1, ..., Fields - 1 of a line, each preceded by Prefix (the settings
+   of fields 0, 1, ..., i - 1).
+*/
+
+static void Expand(int i, char *Prefix)
+{
+    char *Value, *Rest, *Configuration;
+    size_t Length;
+
+    if (i == Fields) {
+        if (ConfigurationCount == ConfigurationSpace)
+            assert(Configurations = (char **)
+                   realloc(Configurations,
+                           (ConfigurationSpace =
+                            2 * ConfigurationSpace + 16) *
+                           sizeof(char *)));
+        assert(Configuration = (char *) malloc(strlen(Prefix) + 1));
+        strcpy(Configuration, Prefix);
+        Configurations[ConfigurationCount++] = Configuration;
+        if (strlen(Prefix) >= ScratchSpace) {
+            ScratchSpace = 2 * strlen(Prefix) + 1;
+            assert(Scratch = (char *) realloc(Scratch, ScratchSpace));
+            assert(LabelBuffer =
+                   (char *) realloc(LabelBuffer, ScratchSpace));
+        }
+        return;
+    }
+    for (Value = Values[i];; Value = Rest + 1) {
+        Rest = strchr(Value, ',');
+        Value += strspn(Value, " \t");
+        Length = Rest ? (size_t) (Rest - Value) : strlen(Value);
+        while (Length > 0 && isspace((unsigned char) Value[Length - 1]))
+            Length--;
+        if (Length == 0)
+            eprintf("Value of %s expected", Keys[i]);
+        assert(Configuration = (char *)
+               malloc(strlen(Prefix) + strlen(Keys[i]) + Length + 3));
+        sprintf(Configuration, "%s%s%s=%.*s", Prefix, *Prefix ? ";" : "",
+                Keys[i], (int) Length, Value);
+        Expand(i + 1, Configuration);
+        free(Configuration);
+        if (!Rest)
+            break;
+    }
+}
+
+/*
+   The ApplyConfiguration function sets the parameters to those of the
+   parameter file, overridden by the settings of a configuration. It
+   returns the label of the configuration.
+*/
+
+char *ApplyConfiguration(char *Configuration)
+{
+    char *Field, *Rest, *S;
+
+    ResetParameters();
+    strcpy(Scratch, Configuration);
+    for (Field = Scratch; Field; Field = Rest) {
+        if ((Rest = strchr(Field, ';')))
+            *Rest++ = '\0';
+        ReadParameter(Field);
+    }
+    strcpy(LabelBuffer, Configuration);
+    for (S = LabelBuffer; (S = strchr(S, ';')); S++)
+        *S = ',';
+    return LabelBuffer;
+}
+
+static char *Trim(char *S)
+{
+    char *t;
+
+    S += strspn(S, " \t");
+    for (t = S + strlen(S); t > S && isspace((unsigned char) t[-1]); t--);
+    *t = '\0';
+    return S;
+}
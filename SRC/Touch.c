@@ -0,0 +1,27 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The Touch function records that the tour neighbors of a node have 
+   changed.
+
+   The "touched" nodes are kept in a list, where FirstTouched denotes the 
+   first node. The list is implemented as a singly linked list in which the 
+   NextTouched field of each node references the successor node. The last 
+   node of the list references itself.
+
+   A node is member of the list iff its NextTouched != 0. The function has 
+   no effect if the node is already in the list.
+
+   The list is used by the Gain23 function when GAIN23 = ACTIVE, and is
+   emptied each time Gain23 fails to find an improvement.
+
+   The function is called from the StoreTour and InitializeTrial functions.
+*/
+
+void Touch(Node * t)
+{
+    if (t->NextTouched != 0)
+        return;
+    t->NextTouched = FirstTouched ? FirstTouched : t;
+    FirstTouched = t;
+}
@@ -0,0 +1,173 @@
+#include "INCLUDE/Segment.h"
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file let a trial that starts from a kicked best
+   tour (KICK_TYPE = SEGMENT_DOUBLE_BRIDGE) be prepared in time that
+   depends on how much the tour has changed, not on the number of nodes.
+
+   The trial log holds the 2-opt moves (swaps) made on the tour since it
+   was last equal to the currently best tour of the run (BestSuc): the
+   swaps of the kick (see KickSwap) and the swaps committed by the
+   Lin-Kernighan search (see StoreTour). If the trial does not give a
+   better tour, RestoreBestTour undoes the logged swaps in reverse order.
+   Since Flip reverses the same segment when a swap is undone, this
+   restores Pred, Suc, Rank and Hash exactly, in time proportional to the
+   lengths of the reversed segments.
+
+   Only the end nodes of the swaps made between two trials (by
+   RestoreBestTour and by the kick) may have got new tour neighbors. They
+   are collected, and InitializeTrial takes them one by one by calling
+   RemoveMovedNode. The nodes of each reversed segment are marked for the
+   worker threads (see MarkChanged).
+
+   The log can only be used as long as the tour is changed by swaps, and
+   InitializeTrial has initialized the nodes for the tour at hand
+   (ValidateTrialLog). When the tour is changed by other means (a new
+   initial tour, or the incumbent of the portfolio adopted by Link),
+   InvalidateTrialLog is called; RestoreBestTour then fails, and the next
+   trial is initialized in full. ClearTrialLog is called when the tour is
+   the best tour (RecordBetterTour).
+*/
+
+static SwapRecord *Log = 0;     /* The swaps since the tour was the best */
+static long LogCount = 0, LogSpace = 0;
+static Node **Moved = 0;        /* The end nodes of swaps between trials */
+static long MovedCount = 0, MovedSpace = 0;
+static int Valid = 0;           /* 1, if the log may be used */
+
+static void LogSwap(SwapRecord * S);
+static void MarkSegment(SwapRecord * S);
+static void AddMoved(SwapRecord * S);
+
+/*
+   The LogSwaps function appends the swaps on SwapStack to the log. It is
+   called by StoreTour before the swaps are removed from the stack.
+*/
+
+void LogSwaps()
+{
+    long i;
+
+    if (KickType != SEGMENT_DOUBLE_BRIDGE || WorkerThread)
+        return;
+    for (i = 0; i < Swaps; i++)
+        LogSwap(&SwapStack[i]);
+}
+
+/*
+   The KickSwap function makes the 2-opt move Swap1(t1, t2, t3) as a part
+   of a kick and logs it. The move is not left on SwapStack. If t3 is a
+   neighbor of t2, the move does not change the tour, and nothing is done.
+*/
+
+void KickSwap(Node * t1, Node * t2, Node * t3)
+{
+    if (t3 == t2->Pred || t3 == t2->Suc)
+        return;
+    Swap1(t1, t2, t3);
+    Swaps--;
+    LogSwap(&SwapStack[Swaps]);
+    MarkSegment(&SwapStack[Swaps]);
+    AddMoved(&SwapStack[Swaps]);
+}
+
+/*
+   The RestoreBestTour function undoes the logged swaps, so that the tour
+   becomes the currently best tour of the run. It returns 1 on success, and
+   0 if the log cannot be used (the tour is then left unchanged).
+*/
+
+int RestoreBestTour()
+{
+    SwapRecord *S;
+
+    if (!Valid)
+        return 0;
+    while (LogCount > 0) {
+        S = &Log[--LogCount];
+        MarkSegment(S);
+        AddMoved(S);
+        Swap1(S->t3, S->t2, S->t1);
+        Swaps--;
+    }
+    return 1;
+}
+
+/*
+   The RemoveMovedNode function removes a node from the collection of end
+   nodes of swaps made since the last call of InitializeTrial, and returns
+   it. A node may be returned more than once. The function returns 0 when
+   the collection is empty.
+*/
+
+Node *RemoveMovedNode()
+{
+    return MovedCount > 0 ? Moved[--MovedCount] : 0;
+}
+
+void ClearTrialLog()
+{
+    LogCount = 0;
+}
+
+int TrialLogValid()
+{
+    return Valid;
+}
+
+void ValidateTrialLog()
+{
+    MovedCount = 0;
+    Valid = 1;
+}
+
+void InvalidateTrialLog()
+{
+    LogCount = MovedCount = 0;
+    Valid = 0;
+}
+
+static void LogSwap(SwapRecord * S)
+{
+    if (LogCount == LogSpace) {
+        LogSpace = LogSpace ? 2 * LogSpace : 1024;
+        assert(Log =
+               (SwapRecord *) realloc(Log, LogSpace * sizeof(SwapRecord)));
+    }
+    Log[LogCount++] = *S;
+}
+
+/*
+   After a swap has been made by Flip, the reversed segment runs from t1
+   to t3 in the successor direction. MarkSegment marks its nodes and t2
+   and t4 for the worker threads.
+*/
+
+static void MarkSegment(SwapRecord * S)
+{
+    Node *N = S->t1;
+
+    MarkChanged(N);
+#ifndef SEGMENT_LIST
+    while (N != S->t3)
+        MarkChanged(N = N->Suc);
+#else
+    MarkChanged(S->t3);
+#endif
+    MarkChanged(S->t2);
+    MarkChanged(S->t4);
+}
+
+static void AddMoved(SwapRecord * S)
+{
+    if (MovedCount + 4 > MovedSpace) {
+        MovedSpace = MovedSpace ? 2 * MovedSpace : 1024;
+        assert(Moved =
+               (Node **) realloc(Moved, MovedSpace * sizeof(Node *)));
+    }
+    Moved[MovedCount++] = S->t1;
+    Moved[MovedCount++] = S->t2;
+    Moved[MovedCount++] = S->t3;
+    Moved[MovedCount++] = S->t4;
+}
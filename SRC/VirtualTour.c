@@ -0,0 +1,211 @@
+#include "INCLUDE/LK.h"
+
+/*
+   The functions in this file maintain a "virtual tour": the tour as it
+   would be if a short sequence of 2-opt moves had been made on the current
+   tour. The current tour is not changed. This makes it possible to evaluate
+   a sequence of moves without flipping the tour and undoing the flips
+   afterwards.
+
+   The virtual tour is represented by a list of segments of the current
+   tour. Each segment is given by its first and last node in the virtual
+   tour, the interval of positions it covers in the current tour, and
+   whether it is reversed. Positions are Rank values counted modulo
+   Dimension from the Origin node. Initially, the list consists of one
+   segment (the whole tour). A 2-opt move splits at most two segments and
+   reverses a contiguous range of segments. Thus, after k moves the list
+   contains at most 2k + 1 segments, and each query takes O(k) time.
+
+   ResetVirtualTour(Origin) makes the virtual tour equal to the current tour.
+   VirtualFlip(t1, t2, t3, t4) makes the 2-opt move that exchanges edges
+   (t1,t2) and (t3,t4) with edges (t2,t3) and (t4,t1) on the virtual tour.
+   VirtualSUC(a) and VirtualPRED(a) return the successor and predecessor of
+   node a in the virtual tour. VirtualBETWEEN(a, b, c) returns 1 if node b
+   is between a and c in the virtual tour; otherwise 0.
+
+   The orientation of the virtual tour is arbitrary: a move may reverse
+   the complement of the range of nodes it logically reverses. Callers should
+   therefore only use the virtual tour in orientation-independent ways.
+
+   The functions presume the doubly linked list representation of tours.
+   The state is private to each thread.
+*/
+
+typedef struct VirtualSegment {
+    Node *First, *Last;         /* The first and last node */
+    long Low, High;             /* The interval of positions covered */
+    int Reversed;               /* Is the segment reversed? */
+} VirtualSegment;
+
+static __thread VirtualSegment *Segments = 0;
+static __thread int SegmentCount = 0, SegmentSpace = 0;
+static __thread long OriginRank;
+
+static long Position(Node * a);
+static int Find(Node * a);
+static long Index(Node * a);
+static void Split(Node * a);
+static void Reverse(Node * a, Node * b);
+
+void ResetVirtualTour(Node * Origin)
+{
+    if (SegmentSpace == 0) {
+        SegmentSpace = 16;
+        assert(Segments =
+               (VirtualSegment *) malloc(SegmentSpace *
+                                         sizeof(VirtualSegment)));
+    }
+    OriginRank = Origin->Rank;
+    SegmentCount = 1;
+    Segments[0].First = Origin;
+    Segments[0].Last = Origin->Pred;
+    Segments[0].Low = 0;
+    Segments[0].High = Dimension - 1;
+    Segments[0].Reversed = 0;
+}
+
+Node *VirtualSUC(Node * a)
+{
+    int i = Find(a);
+    VirtualSegment *S = &Segments[i];
+
+    if (a == S->Last)
+        return Segments[i + 1 < SegmentCount ? i + 1 : 0].First;
+    return S->Reversed ? a->Pred : a->Suc;
+}
+
+Node *VirtualPRED(Node * a)
+{
+    int i = Find(a);
+    VirtualSegment *S = &Segments[i];
+
+    if (a == S->First)
+        return Segments[i > 0 ? i - 1 : SegmentCount - 1].Last;
+    return S->Reversed ? a->Suc : a->Pred;
+}
+
+int VirtualBETWEEN(Node * a, Node * b, Node * c)
+{
+    long ia = Index(a), ib = Index(b), ic = Index(c);
+
+    return ia <= ic ? ib >= ia && ib <= ic : ib >= ia || ib <= ic;
+}
+
+void VirtualFlip(Node * t1, Node * t2, Node * t3, Node * t4)
+{
+    if (VirtualSUC(t1) == t2)
+        Reverse(t2, t4);
+    else
+        Reverse(t1, t3);
+}
+
+/*
+   Position returns the position of node a in the current tour, counted
+   from the Origin node.
+*/
+
+static long Position(Node * a)
+{
+    long p = (a->Rank - OriginRank) % Dimension;
+
+    return p < 0 ? p + Dimension : p;
+}
+
+/*
+   Find returns the index of the segment containing node a.
+*/
+
+static int Find(Node * a)
+{
+    long p = Position(a);
+    int i;
+
+    for (i = 0; i < SegmentCount; i++)
+        if (p >= Segments[i].Low && p <= Segments[i].High)
+            return i;
+    assert(0);
+    return -1;
+}
+
+/*
+   Index returns the position of node a in the virtual tour.
+*/
+
+static long Index(Node * a)
+{
+    long p = Position(a), Offset = 0;
+    VirtualSegment *S;
+
+    for (S = Segments; p < S->Low || p > S->High; S++)
+        Offset += S->High - S->Low + 1;
+    return Offset + (S->Reversed ? S->High - p : p - S->Low);
+}
+
+/*
+   Split makes node a the first node of its segment.
+*/
+
+static void Split(Node * a)
+{
+    int i = Find(a);
+    VirtualSegment *S;
+    long p = Position(a);
+
+    if (a == Segments[i].First)
+        return;
+    if (SegmentCount == SegmentSpace) {
+        SegmentSpace *= 2;
+        assert(Segments =
+               (VirtualSegment *) realloc(Segments,
+                                          SegmentSpace *
+                                          sizeof(VirtualSegment)));
+    }
+    memmove(&Segments[i + 1], &Segments[i],
+            (SegmentCount - i) * sizeof(VirtualSegment));
+    SegmentCount++;
+    S = &Segments[i];
+    S->Last = S->Reversed ? a->Suc : a->Pred;
+    (S + 1)->First = a;
+    if (!S->Reversed) {
+        S->High = p - 1;
+        (S + 1)->Low = p;
+    } else {
+        S->Low = p + 1;
+        (S + 1)->High = p;
+    }
+}
+
+/*
+   Reverse reverses the path from node a to node b in the virtual tour.
+   If the path wraps around the end of the segment list, its complement
+   is reversed instead.
+*/
+
+static void Reverse(Node * a, Node * b)
+{
+    VirtualSegment T;
+    Node *c;
+    int i, j;
+
+    if (Index(a) > Index(b)) {
+        c = a;
+        a = VirtualSUC(b);
+        b = VirtualPRED(c);
+    }
+    c = VirtualSUC(b);
+    Split(a);
+    Split(c);
+    i = Find(a);
+    j = Find(b);
+    for (; i <= j; i++, j--) {
+        T = Segments[i];
+        Segments[i] = Segments[j];
+        Segments[j] = T;
+    }
+    for (i = Find(b), j = Find(a); i <= j; i++) {
+        c = Segments[i].First;
+        Segments[i].First = Segments[i].Last;
+        Segments[i].Last = c;
+        Segments[i].Reversed ^= 1;
+    }
+}
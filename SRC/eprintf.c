@@ -3,6 +3,10 @@
 
 /* 
    The eprintf function prints an error message and exits.
+
+   If ErrorReturn is not 0 (the solver is called through the library), the
+   message is stored in ErrorMessage instead, and control returns to
+   ErrorReturn. Errors in worker threads always exit.
 */
 
 void eprintf(char *fmt, ...)
@@ -10,6 +14,12 @@ void eprintf(char *fmt, ...)
     va_list args;
 
     fflush(stdout);
+    if (ErrorReturn && !WorkerThread) {
+        va_start(args, fmt);
+        vsnprintf(ErrorMessage, sizeof(ErrorMessage), fmt, args);
+        va_end(args);
+        longjmp(*ErrorReturn, 1);
+    }
     va_start(args, fmt);
     vfprintf(stderr, fmt, args);
     va_end(args);